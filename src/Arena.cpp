@@ -0,0 +1,97 @@
+/**
+ * File contains definition of `Arena` class.
+ *
+ * @file Arena.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include "Arena.h"
+
+/**
+ * @brief Constructor for an empty arena.
+ *
+ * No memory is requested from the heap until the first allocation.
+ *
+ * @param blockSize the size of each block of memory requested from the heap, in bytes
+ */
+Arena::Arena(std::size_t blockSize) {
+    this->blockSize = blockSize;
+}
+
+/**
+ * @brief Destructor destroys every object created in the arena and releases its memory.
+ */
+Arena::~Arena() {
+    reset();
+}
+
+/**
+ * @brief Allocates memory from the arena.
+ *
+ * The memory is taken from the current block if it fits, otherwise from the next block kept from before the last
+ * reset which it fits in. A new block is only requested from the heap if no kept block has room, and is made larger
+ * than the usual block size if needed.
+ *
+ * @param size the number of bytes to allocate
+ * @param alignment the alignment of the memory, which must be a power of two
+ * @return pointer to the allocated memory
+ */
+void *Arena::allocate(std::size_t size, std::size_t alignment) {
+    while (currentBlock < blocks.size()) {
+        Block &block = blocks[currentBlock];
+        auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        std::uintptr_t aligned = (base + offset + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+        std::size_t end = (aligned - base) + size;
+        if (end <= block.size) {
+            bytesUsed += end - offset;
+            offset = end;
+            return reinterpret_cast<void *>(aligned);
+        }
+        currentBlock++;
+        offset = 0;
+    }
+    std::size_t newSize = std::max(blockSize, size + alignment);
+    blocks.push_back({std::unique_ptr<char[]>(new char[newSize]), newSize});
+    return allocate(size, alignment);
+}
+
+/**
+ * @brief Destroys every object created in the arena and rewinds it, keeping its blocks for reuse.
+ *
+ * Objects are destroyed in the reverse of the order they were created, so that objects may refer to older objects in
+ * their destructors.
+ */
+void Arena::reset() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); it++) {
+        it->destroy(it->object);
+    }
+    destructors.clear();
+    currentBlock = 0;
+    offset = 0;
+    bytesUsed = 0;
+}
+
+/**
+ * @brief Getter for the number of bytes allocated since the arena was last reset, including alignment padding.
+ *
+ * @return the number of bytes used
+ */
+std::size_t Arena::getBytesUsed() const {
+    return bytesUsed;
+}
+
+/**
+ * @brief Getter for the total size of the blocks held by the arena.
+ *
+ * @return the capacity of the arena, in bytes
+ */
+std::size_t Arena::getCapacity() const {
+    std::size_t capacity = 0;
+    for (const Block &block: blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
@@ -0,0 +1,99 @@
+/**
+ * File contains declaration for `Arena` class.
+ *
+ * @file Arena.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define ARENA_BLOCK_SIZE 16384  // size of each block of memory requested from the heap, in bytes.
+
+/**
+ * @brief Declaration for `Arena` class.
+ *
+ * Class provides a region of memory from which the objects of a game are allocated by bumping an offset, and which is
+ * released in one go when the game ends. Memory is requested from the heap in large blocks, which are kept when the
+ * arena is reset, so that a game which is restarted reuses the memory of the previous match instead of returning it to
+ * the heap and requesting it again.
+ *
+ * Objects created in the arena are destroyed, in the reverse of the order they were created, when the arena is reset
+ * or destroyed. They must not be deleted individually.
+ */
+class Arena {
+private:
+    /**
+     * @brief Declaration of `Block` structure.
+     *
+     * Holds a block of memory requested from the heap.
+     */
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    /**
+     * @brief Declaration of `Destructor` structure.
+     *
+     * Holds an object created in the arena along with the function which destroys it.
+     */
+    struct Destructor {
+        void (*destroy)(void *object);
+        void *object;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<Destructor> destructors;
+    std::size_t blockSize;
+    std::size_t currentBlock = 0;
+    std::size_t offset = 0;
+    std::size_t bytesUsed = 0;
+
+public:
+    explicit Arena(std::size_t blockSize = ARENA_BLOCK_SIZE);
+
+    ~Arena();
+
+    Arena(const Arena &arena) = delete;
+
+    Arena &operator=(const Arena &arena) = delete;
+
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Creates an object in the arena.
+     *
+     * The object is destroyed when the arena is reset or destroyed, unless it is trivially destructible, in which case
+     * its memory is simply reused.
+     *
+     * @tparam T the type of the object
+     * @tparam Args the types of the arguments of the constructor
+     * @param args the arguments passed to the constructor
+     * @return pointer to the new object
+     */
+    template<typename T, typename... Args>
+    T *create(Args &&...args) {
+        T *object = new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.push_back({[](void *memory) { static_cast<T *>(memory)->~T(); }, object});
+        }
+        return object;
+    }
+
+    void reset();
+
+    std::size_t getBytesUsed() const;
+
+    std::size_t getCapacity() const;
+};
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * File contains definition of concrete `BufferedInputSource` class.
+ *
+ * @file BufferedInputSource.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include "BufferedInputSource.h"
+
+/**
+ * @brief Constructor for a new, empty input source.
+ */
+BufferedInputSource::BufferedInputSource() = default;
+
+/**
+ * @brief Default destructor.
+ *
+ * No memory is allocated.
+ */
+BufferedInputSource::~BufferedInputSource() = default;
+
+/**
+ * @brief Appends an input event to the buffer.
+ *
+ * @param event the input event to be supplied
+ */
+void BufferedInputSource::push(const InputEvent &event) {
+    events.push_back(event);
+}
+
+/**
+ * @brief Appends a key press of a character to the buffer, timestamped with the current time.
+ *
+ * @param key the character of the key press
+ */
+void BufferedInputSource::push(char key) {
+    events.push_back({key == 27 ? Key::ESCAPE : Key::CHARACTER, key, MODIFIER_NONE,
+                      std::chrono::steady_clock::now()});
+}
+
+/**
+ * @brief Gets the input event at the front of the buffer, without waiting.
+ *
+ * @param event set to the input event at the front of the buffer, if the buffer is not empty
+ * @param timeout ignored, as no more input can arrive while waiting
+ * @return true if an input event was removed, false if the buffer is empty
+ */
+bool BufferedInputSource::waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) {
+    if (events.empty()) {
+        return false;
+    }
+    event = events.front();
+    events.pop_front();
+    return true;
+}
+
+/**
+ * @brief Gets the character of the next key press in the buffer which produces one, without waiting.
+ *
+ * @return the character of the key press, '\0' if the buffer is exhausted
+ */
+char BufferedInputSource::waitForKey() {
+    InputEvent event{};
+    while (waitForEvent(event, std::chrono::milliseconds(0))) {
+        if (event.character != '\0') {
+            return event.character;
+        }
+    }
+    return '\0';
+}
+
+/**
+ * @brief Returns immediately, as buffered input is not paced by the clock.
+ *
+ * @param deadline ignored
+ */
+void BufferedInputSource::waitUntil(std::chrono::steady_clock::time_point deadline) {}
+
+/**
+ * @brief Removes every buffered input event at once.
+ *
+ * @param drained cleared, then filled with the buffered input events in order
+ * @return the number of input events removed
+ */
+size_t BufferedInputSource::drain(std::vector<InputEvent> &drained) {
+    drained.assign(events.begin(), events.end());
+    events.clear();
+    return drained.size();
+}
@@ -0,0 +1,44 @@
+/**
+ * File contains declaration for concrete `BufferedInputSource` class.
+ *
+ * @file BufferedInputSource.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef BUFFERED_INPUT_SOURCE_H
+#define BUFFERED_INPUT_SOURCE_H
+
+#include <deque>
+#include "InputSource.h"
+
+/**
+ * @brief Declaration for concrete `BufferedInputSource` class.
+ *
+ * Class provides an implementation of abstract superclass `InputSource` which supplies input events pushed to it by
+ * the program, rather than read from the user. It never blocks: waiting for input when none is buffered returns
+ * immediately, and `waitForKey` returns the null character ('\0') once the buffer is exhausted.
+ */
+class BufferedInputSource : public InputSource {
+private:
+    std::deque<InputEvent> events;
+
+public:
+    BufferedInputSource();
+
+    ~BufferedInputSource() override;
+
+    void push(const InputEvent &event);
+
+    void push(char key);
+
+    bool waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) override;
+
+    char waitForKey() override;
+
+    void waitUntil(std::chrono::steady_clock::time_point deadline) override;
+
+    size_t drain(std::vector<InputEvent> &drained) override;
+};
+
+#endif
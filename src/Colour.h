@@ -12,9 +12,10 @@
 /**
  * @brief Declaration of `Colour` enumeration.
  *
- * Currently supports the 8 standard ANSI terminal colours.
+ * Currently supports the 8 standard ANSI terminal colours. Values are stored in a single byte so that they pack
+ * tightly into frame buffer cells.
  */
-enum class Colour {
+enum class Colour : unsigned char {
     BLACK,
     RED,
     GREEN,
@@ -6,16 +6,19 @@
  * @date 30/10/21
  */
 
+#include <algorithm>
+#include <limits>
 #include "Entity.h"
 
-#include <utility>
-
 /**
  * @brief Constructor for a new `Entity` of the type of a concrete subclass.
  *
  * Constructs a new instance of a concrete subclass of `Entity` with the provided x and y coordinates, x and y
- * velocities, width, height and colour.
+ * velocities, width, height and colour. The state of the entity is created in the provided registry, which the new
+ * instance views and is attached to as the behaviour of the entity. The character representation is interned in the
+ * `GlyphTable`.
  *
+ * @param registry the registry the state of the entity is stored in
  * @param x the x coordinate of the entity
  * @param y the y coordinate of the entity
  * @param xVelocity the x velocity of the entity
@@ -25,42 +28,31 @@
  * @param representation the character representation to be used for the entity
  * @param colour the colour of the entity (where applicable)
  */
-Entity::Entity(float x, float y, float xVelocity, float yVelocity, float width, float height, std::string representation,
-               const Colour &colour) {
-    this->x = x;
-    this->y = y;
-    this->xVelocity = xVelocity;
-    this->yVelocity = yVelocity;
-    this->width = width;
-    this->height = height;
-    this->representation = std::move(representation);
-    this->colour = colour;
+Entity::Entity(EntityRegistry &registry, float x, float y, float xVelocity, float yVelocity, float width, float height,
+               const std::string &representation, const Colour &colour) {
+    this->registry = &registry;
+    this->handle = registry.create(x, y, xVelocity, yVelocity, width, height,
+                                   GlyphTable::getInstance().intern(representation), colour);
+    registry.attach(handle, this);
 }
 
 /**
- * @brief Copy-constructor to create new `Entity` given an existing instance.
- *
- * Copies a previously declared instance of a concrete subclass of `Entity`.
+ * @brief Default destructor.
  *
- * @param entity the previously instantiated entity to be copied
+ * The state of the entity is destroyed in the registry.
  */
-Entity::Entity(const Entity &entity) {
-    this->x = entity.x;
-    this->y = entity.y;
-    this->xVelocity = entity.xVelocity;
-    this->yVelocity = entity.yVelocity;
-    this->width = entity.width;
-    this->height = entity.height;
-    this->representation = entity.representation;
-    this->colour = entity.colour;
+Entity::~Entity() {
+    registry->destroy(handle);
 }
 
 /**
- * @brief Default destructor.
+ * @brief Getter for the handle of the entity in its registry.
  *
- * No memory is allocated.
+ * @return the handle of the entity
  */
-Entity::~Entity() = default;
+EntityHandle Entity::getHandle() const {
+    return handle;
+}
 
 /**
  * @brief Getter for the x coordinate of the entity.
@@ -68,7 +60,7 @@ Entity::~Entity() = default;
  * @return the x coordinate of the entity
  */
 float Entity::getX() const {
-    return x;
+    return registry->getX(handle);
 }
 
 /**
@@ -77,7 +69,7 @@ float Entity::getX() const {
  * @return the y coordinate of the entity
  */
 float Entity::getY() const {
-    return y;
+    return registry->getY(handle);
 }
 
 /**
@@ -86,7 +78,7 @@ float Entity::getY() const {
  * @return the x velocity of the entity
  */
 float Entity::getXVelocity() const {
-    return xVelocity;
+    return registry->getXVelocity(handle);
 }
 
 /**
@@ -95,7 +87,7 @@ float Entity::getXVelocity() const {
  * @return the y velocity of the entity
  */
 float Entity::getYVelocity() const {
-    return yVelocity;
+    return registry->getYVelocity(handle);
 }
 
 /**
@@ -104,7 +96,7 @@ float Entity::getYVelocity() const {
  * @return the width of the entity
  */
 float Entity::getWidth() const {
-    return width;
+    return registry->getWidth(handle);
 }
 
 /**
@@ -113,7 +105,7 @@ float Entity::getWidth() const {
  * @return the height of the entity
  */
 float Entity::getHeight() const {
-    return height;
+    return registry->getHeight(handle);
 }
 
 /**
@@ -121,17 +113,26 @@ float Entity::getHeight() const {
  *
  * @return the string representation of the entity
  */
-std::string Entity::getRepresentation() const {
-    return representation;
+const std::string &Entity::getRepresentation() const {
+    return GlyphTable::getInstance().lookup(registry->getGlyph(handle));
+}
+
+/**
+ * @brief Getter for the id of the interned character representation of the entity.
+ *
+ * @return the glyph id of the entity
+ */
+GlyphId Entity::getGlyph() const {
+    return registry->getGlyph(handle);
 }
 
 /**
- * @brief Getter for the character Colour pair used to display the entity.
+ * @brief Getter for the cell of glyph and colour used to display the entity.
  *
- * @return the character Colour pair of the entity
+ * @return the display cell of the entity
  */
-std::pair<std::string, Colour> Entity::getDisplayPair() const {
-    return std::make_pair(representation, colour);
+Cell Entity::getCell() const {
+    return {registry->getGlyph(handle), registry->getColour(handle)};
 }
 
 /**
@@ -140,7 +141,85 @@ std::pair<std::string, Colour> Entity::getDisplayPair() const {
  * @return the colour of the entity
  */
 Colour Entity::getColour() const {
-    return colour;
+    return registry->getColour(handle);
+}
+
+/**
+ * @brief Getter for the bounding box of the entity, which is centred on its coordinates.
+ *
+ * @return the bounding box of the entity
+ */
+Bounds Entity::getBounds() const {
+    return registry->getBounds(handle);
+}
+
+/**
+ * @brief Sweeps the entity along its velocity relative to another entity.
+ *
+ * Both entities are assumed to move at their current velocities, so the entity is swept with the velocity of the
+ * other entity subtracted from its own.
+ *
+ * @param other the entity that may be hit
+ * @param maxTime the number of ticks to sweep over
+ * @param contact set to the first contact with the other entity, if there is one
+ * @return true if the entities come into contact within the time given
+ */
+bool Entity::sweep(const Entity *other, float maxTime, Contact &contact) const {
+    return sweep(getBounds(), getXVelocity() - other->getXVelocity(), getYVelocity() - other->getYVelocity(),
+                 other->getBounds(), maxTime, contact);
+}
+
+/**
+ * @brief Static helper function finds the time of impact of a moving box with a stationary box.
+ *
+ * For each axis, the times at which the moving box enters and leaves the span of the target box are solved directly
+ * from the velocity. The boxes are in contact once they have entered on both axes, and the axis entered last gives the
+ * surface that was hit. Boxes which touch count as being in contact, while boxes which already overlap, or which only
+ * touch while moving apart, are not reported, so that a moving box which has just been reflected is never caught
+ * again. The target box may extend to infinity, such as for the walls of the board.
+ *
+ * @param moving the bounding box of the moving entity
+ * @param xVelocity the x velocity of the moving box, relative to the target box
+ * @param yVelocity the y velocity of the moving box, relative to the target box
+ * @param target the bounding box of the target
+ * @param maxTime the number of ticks to sweep over
+ * @param contact set to the first contact with the target, if there is one
+ * @return true if the boxes come into contact within the time given
+ */
+bool Entity::sweep(const Bounds &moving, float xVelocity, float yVelocity, const Bounds &target, float maxTime,
+                   Contact &contact) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    float entry[2];
+    float exit[2];
+    float velocity[2] = {xVelocity, yVelocity};
+    float movingMin[2] = {moving.left, moving.top};
+    float movingMax[2] = {moving.right, moving.bottom};
+    float targetMin[2] = {target.left, target.top};
+    float targetMax[2] = {target.right, target.bottom};
+    for (int axis = 0; axis < 2; axis++) {
+        if (velocity[axis] > 0) {
+            entry[axis] = (targetMin[axis] - movingMax[axis]) / velocity[axis];
+            exit[axis] = (targetMax[axis] - movingMin[axis]) / velocity[axis];
+        } else if (velocity[axis] < 0) {
+            entry[axis] = (targetMax[axis] - movingMin[axis]) / velocity[axis];
+            exit[axis] = (targetMin[axis] - movingMax[axis]) / velocity[axis];
+        } else if (movingMax[axis] >= targetMin[axis] && movingMin[axis] <= targetMax[axis]) {
+            entry[axis] = -infinity;
+            exit[axis] = infinity;
+        } else {
+            return false;  // never overlaps on this axis.
+        }
+    }
+    int axis = entry[0] > entry[1] ? 0 : 1;
+    float entryTime = entry[axis];
+    float exitTime = std::min(exit[0], exit[1]);
+    if (entryTime > exitTime || entryTime < 0 || entryTime > maxTime) {
+        return false;
+    }
+    contact.time = entryTime;
+    contact.normalX = axis == 0 ? (velocity[0] > 0 ? -1.0f : 1.0f) : 0.0f;
+    contact.normalY = axis == 1 ? (velocity[1] > 0 ? -1.0f : 1.0f) : 0.0f;
+    return true;
 }
 
 /**
@@ -149,7 +228,7 @@ Colour Entity::getColour() const {
  * @param x the new x coordinate
  */
 void Entity::setX(float x) {
-    this->x = x;
+    registry->setX(handle, x);
 }
 
 /**
@@ -158,7 +237,7 @@ void Entity::setX(float x) {
  * @param y the new y coordinate
  */
 void Entity::setY(float y) {
-    this->y = y;
+    registry->setY(handle, y);
 }
 
 /**
@@ -167,7 +246,7 @@ void Entity::setY(float y) {
  * @param xVelocity the new x velocity
  */
 void Entity::setXVelocity(float xVelocity) {
-    this->xVelocity = xVelocity;
+    registry->setXVelocity(handle, xVelocity);
 }
 
 /**
@@ -176,7 +255,7 @@ void Entity::setXVelocity(float xVelocity) {
  * @param yVelocity the new y velocity
  */
 void Entity::setYVelocity(float yVelocity) {
-    this->yVelocity = yVelocity;
+    registry->setYVelocity(handle, yVelocity);
 }
 
 /**
@@ -185,7 +264,7 @@ void Entity::setYVelocity(float yVelocity) {
  * @param width thew new width
  */
 void Entity::setWidth(float width) {
-    this->width = width;
+    registry->setWidth(handle, width);
 }
 
 /**
@@ -194,16 +273,18 @@ void Entity::setWidth(float width) {
  * @param height the new height
  */
 void Entity::setHeight(float height) {
-    this->height = height;
+    registry->setHeight(handle, height);
 }
 
 /**
  * @brief Setter for the character representation of the entity.
  *
+ * The representation is interned in the `GlyphTable`.
+ *
  * @param representation the new string representation
  */
-void Entity::setRepresentation(std::string representation) {
-    this->representation = representation;
+void Entity::setRepresentation(const std::string &representation) {
+    registry->setGlyph(handle, GlyphTable::getInstance().intern(representation));
 }
 
 /**
@@ -212,5 +293,25 @@ void Entity::setRepresentation(std::string representation) {
  * @param colour the new colour object
  */
 void Entity::setColour(const Colour &colour) {
-    this->colour = colour;
+    registry->setColour(handle, colour);
+}
+
+/**
+ * @brief Getter for the time the entity has remaining in the current tick.
+ *
+ * @return the remaining time, in ticks
+ */
+float Entity::getRemainingTime() const {
+    return registry->getRemainingTime(handle);
+}
+
+/**
+ * @brief Moves the entity along its velocity for part of the time it has remaining in the tick.
+ *
+ * The rest of the time is integrated by the registry, along with every other entity.
+ *
+ * @param time the time to move the entity for, in ticks
+ */
+void Entity::advance(float time) {
+    registry->advance(handle, time);
 }
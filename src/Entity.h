@@ -13,34 +13,51 @@
 #include <vector>
 #include <map>
 #include "Colour.h"
+#include "EntityRegistry.h"
+#include "FrameBuffer.h"
 #include <cmath>
 
+class SpatialGrid;
+
+/**
+ * @brief Declaration of `Contact` structure.
+ *
+ * Describes the first contact found by a sweep: the time until contact, in ticks, and the normal of the surface that
+ * was hit, which points away from that surface.
+ */
+struct Contact {
+    float time;
+    float normalX;
+    float normalY;
+};
+
 /**
  * @brief Declaration for abstract `Entity` class.
  *
- * Class provides declarations required for concrete subclass implementation. Definitions are provided for constructors,
- * a destructor and basic getter/setter methods.
+ * Class provides declarations required for concrete subclass implementation. Definitions are provided for a
+ * constructor, a destructor and basic getter/setter methods.
+ *
+ * The state of an entity is stored in an `EntityRegistry`, and an instance is a view of that state which provides the
+ * behaviour of the entity. Instances therefore cannot be copied.
  */
 class Entity {
 protected:
-    float x;
-    float y;
-    float xVelocity;
-    float yVelocity;
-    float width;
-    float height;
-    std::string representation;
-    Colour colour;
+    EntityRegistry *registry;
+    EntityHandle handle;
 
 public:
-    Entity(float x, float y, float xVelocity, float yVelocity, float width, float height, std::string representation,
-           const Colour &colour);
+    Entity(EntityRegistry &registry, float x, float y, float xVelocity, float yVelocity, float width, float height,
+           const std::string &representation, const Colour &colour);
+
+    Entity(const Entity &entity) = delete;
 
-    Entity(const Entity &entity);
+    Entity &operator=(const Entity &entity) = delete;
 
     virtual ~Entity() = 0;
 
-    virtual void update(const std::map<std::string, Entity *> &entities, int boardWidth, int boardHeight) = 0;
+    virtual void update(const SpatialGrid &grid, int boardWidth, int boardHeight) = 0;
+
+    EntityHandle getHandle() const;
 
     float getX() const;
 
@@ -54,12 +71,25 @@ public:
 
     float getHeight() const;
 
-    std::string getRepresentation() const;
+    const std::string &getRepresentation() const;
+
+    GlyphId getGlyph() const;
 
-    std::pair<std::string, Colour> getDisplayPair() const;
+    Cell getCell() const;
 
     Colour getColour() const;
 
+    Bounds getBounds() const;
+
+    float getRemainingTime() const;
+
+    void advance(float time);
+
+    bool sweep(const Entity *other, float maxTime, Contact &contact) const;
+
+    static bool sweep(const Bounds &moving, float xVelocity, float yVelocity, const Bounds &target, float maxTime,
+                      Contact &contact);
+
     void setX(float x);
 
     void setY(float y);
@@ -72,7 +102,7 @@ public:
 
     void setHeight(float height);
 
-    void setRepresentation(std::string representation);
+    void setRepresentation(const std::string &representation);
 
     void setColour(const Colour &colour);
 
@@ -0,0 +1,208 @@
+/**
+ * File contains definition of `EntityRegistry` class.
+ *
+ * @file EntityRegistry.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include "EntityRegistry.h"
+
+/**
+ * @brief Creates a new entity with the provided state.
+ *
+ * The handle of a destroyed entity is reused if there is one, otherwise every array is grown by one element. The new
+ * entity has no name, no attached behaviour and the whole of the current tick remaining.
+ *
+ * @param x the x coordinate of the entity
+ * @param y the y coordinate of the entity
+ * @param xVelocity the x velocity of the entity
+ * @param yVelocity the y velocity of the entity
+ * @param width the width of the entity
+ * @param height the height of the entity
+ * @param glyph the glyph id of the entity
+ * @param colour the colour of the entity
+ * @return the handle of the new entity
+ */
+EntityHandle EntityRegistry::create(float x, float y, float xVelocity, float yVelocity, float width, float height,
+                                    GlyphId glyph, Colour colour) {
+    EntityHandle handle;
+    if (freeHandles.empty()) {
+        handle = (EntityHandle)alive.size();
+        this->x.push_back(x);
+        this->y.push_back(y);
+        this->xVelocity.push_back(xVelocity);
+        this->yVelocity.push_back(yVelocity);
+        this->width.push_back(width);
+        this->height.push_back(height);
+        this->remainingTime.push_back(1);
+        this->glyph.push_back(glyph);
+        this->colour.push_back(colour);
+        this->boundary.push_back(BOUNDARY_NONE);
+        this->alive.push_back(true);
+        this->behaviours.push_back(nullptr);
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        this->x[handle] = x;
+        this->y[handle] = y;
+        this->xVelocity[handle] = xVelocity;
+        this->yVelocity[handle] = yVelocity;
+        this->width[handle] = width;
+        this->height[handle] = height;
+        this->remainingTime[handle] = 1;
+        this->glyph[handle] = glyph;
+        this->colour[handle] = colour;
+        this->boundary[handle] = BOUNDARY_NONE;
+        this->alive[handle] = true;
+        this->behaviours[handle] = nullptr;
+    }
+    count++;
+    return handle;
+}
+
+/**
+ * @brief Destroys an entity, so that its handle can be reused.
+ *
+ * The entity is stopped, so that integrating its slot has no effect, and its name is removed. Handles which do not
+ * refer to an existing entity are ignored.
+ *
+ * @param handle the handle of the entity
+ */
+void EntityRegistry::destroy(EntityHandle handle) {
+    if (!isAlive(handle)) {
+        return;
+    }
+    for (auto it = names.begin(); it != names.end(); it++) {
+        if (it->second == handle) {
+            names.erase(it);
+            break;
+        }
+    }
+    xVelocity[handle] = 0;
+    yVelocity[handle] = 0;
+    alive[handle] = false;
+    behaviours[handle] = nullptr;
+    freeHandles.push_back(handle);
+    count--;
+}
+
+/**
+ * @brief Removes every entity, so that handles are given out from zero again.
+ *
+ * The storage of the arrays is kept for the entities created next. Attached behaviours are not destroyed.
+ */
+void EntityRegistry::clear() {
+    x.clear();
+    y.clear();
+    xVelocity.clear();
+    yVelocity.clear();
+    width.clear();
+    height.clear();
+    remainingTime.clear();
+    glyph.clear();
+    colour.clear();
+    boundary.clear();
+    alive.clear();
+    behaviours.clear();
+    freeHandles.clear();
+    names.clear();
+    count = 0;
+}
+
+/**
+ * @brief Gives an entity a name, by which its handle can be found.
+ *
+ * @param handle the handle of the entity
+ * @param name the name of the entity
+ */
+void EntityRegistry::setName(EntityHandle handle, const std::string &name) {
+    for (auto &entry: names) {
+        if (entry.first == name) {
+            entry.second = handle;
+            return;
+        }
+    }
+    names.emplace_back(name, handle);
+}
+
+/**
+ * @brief Finds the handle of a named entity.
+ *
+ * @param name the name of the entity
+ * @return the handle of the entity, or `INVALID_HANDLE` if no entity has the name
+ */
+EntityHandle EntityRegistry::find(const std::string &name) const {
+    for (const auto &entry: names) {
+        if (entry.first == name) {
+            return entry.second;
+        }
+    }
+    return INVALID_HANDLE;
+}
+
+/**
+ * @brief Attaches the behaviour of an entity.
+ *
+ * @param handle the handle of the entity
+ * @param behaviour the behaviour of the entity
+ */
+void EntityRegistry::attach(EntityHandle handle, Entity *behaviour) {
+    behaviours[handle] = behaviour;
+}
+
+/**
+ * @brief Sets how an entity behaves at the top and bottom of the board when it is integrated.
+ *
+ * @param handle the handle of the entity
+ * @param boundary one of `BOUNDARY_NONE`, `BOUNDARY_CLAMP` or `BOUNDARY_REFLECT`
+ */
+void EntityRegistry::setBoundary(EntityHandle handle, int boundary) {
+    this->boundary[handle] = boundary;
+}
+
+/**
+ * @brief Moves an entity along its velocity for part of the time it has remaining in the tick.
+ *
+ * @param handle the handle of the entity
+ * @param time the time to move the entity for, in ticks
+ */
+void EntityRegistry::advance(EntityHandle handle, float time) {
+    x[handle] += xVelocity[handle] * time;
+    y[handle] += yVelocity[handle] * time;
+    remainingTime[handle] -= time;
+}
+
+/**
+ * @brief Moves every entity along its velocity for the time it has remaining in the tick.
+ *
+ * Every entity is then given a whole tick for the next update, and is clamped to or reflected from the top and bottom
+ * of the board according to its boundary. Destroyed entities are stopped, so they are integrated without effect.
+ *
+ * @param boardHeight the height of the board
+ */
+void EntityRegistry::integrate(int boardHeight) {
+    EntityArrays arrays{x.data(), y.data(), xVelocity.data(), yVelocity.data(), remainingTime.data(), height.data(),
+                        boundary.data(), alive.size()};
+    integrateEntities(arrays, boardHeight);
+}
+
+/**
+ * @brief Getter for the number of entities which exist.
+ *
+ * @return the number of entities
+ */
+int EntityRegistry::size() const {
+    return count;
+}
+
+/**
+ * @brief Getter for the number of handles in use, including those of destroyed entities awaiting reuse.
+ *
+ * Every handle of an existing entity is less than the capacity.
+ *
+ * @return the number of handles
+ */
+EntityHandle EntityRegistry::capacity() const {
+    return (EntityHandle)alive.size();
+}
@@ -0,0 +1,298 @@
+/**
+ * File contains declaration for `EntityRegistry` class.
+ *
+ * @file EntityRegistry.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef ENTITY_REGISTRY_H
+#define ENTITY_REGISTRY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Colour.h"
+#include "GlyphTable.h"
+#include "PhysicsKernel.h"
+
+#define INVALID_HANDLE (-1)
+
+using EntityHandle = int;
+
+class Entity;
+
+/**
+ * @brief Declaration of `Bounds` structure.
+ *
+ * Holds the axis-aligned bounding box of an entity, where the top edge has the smaller y coordinate.
+ */
+struct Bounds {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+/**
+ * @brief Declaration for `EntityRegistry` class.
+ *
+ * Class stores the state of every entity in a game as a structure of arrays, with one contiguous array each for
+ * position, velocity, size, glyph and colour, so that the whole game can be moved in a single tight loop. Each entity
+ * is referred to by an integer handle, its index into the arrays, which is stable for as long as the entity exists.
+ * Handles of destroyed entities are reused.
+ *
+ * An entity may be given a name, so that a game can look up the handles of its entities once, when it is set up. As
+ * names are only looked up during setup, they are kept in a short list rather than a map, which can be emptied without
+ * releasing its storage. The behaviour of an entity, such as how it reacts to collisions, is provided by the `Entity`
+ * object attached to it.
+ *
+ * Position is integrated over the time each entity has remaining in the tick, by the vector kernels of
+ * `PhysicsKernel.h`. An entity which resolves its own collisions advances itself to the point of contact, using up
+ * some of its time, and the rest of the tick is integrated with all other entities.
+ */
+class EntityRegistry {
+private:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> xVelocity;
+    std::vector<float> yVelocity;
+    std::vector<float> width;
+    std::vector<float> height;
+    std::vector<float> remainingTime;
+    std::vector<GlyphId> glyph;
+    std::vector<Colour> colour;
+    std::vector<std::int32_t> boundary;
+    std::vector<unsigned char> alive;
+    std::vector<Entity *> behaviours;
+    std::vector<EntityHandle> freeHandles;
+    std::vector<std::pair<std::string, EntityHandle>> names;
+    int count = 0;
+
+public:
+    EntityHandle create(float x, float y, float xVelocity, float yVelocity, float width, float height,
+                        GlyphId glyph, Colour colour);
+
+    void destroy(EntityHandle handle);
+
+    void clear();
+
+    void setName(EntityHandle handle, const std::string &name);
+
+    EntityHandle find(const std::string &name) const;
+
+    void attach(EntityHandle handle, Entity *behaviour);
+
+    void setBoundary(EntityHandle handle, int boundary);
+
+    void advance(EntityHandle handle, float time);
+
+    void integrate(int boardHeight);
+
+    int size() const;
+
+    EntityHandle capacity() const;
+
+    /**
+     * @brief Checks whether a handle refers to an entity which exists.
+     *
+     * @param handle the handle to check
+     * @return true if the entity exists
+     */
+    bool isAlive(EntityHandle handle) const {
+        return handle >= 0 && handle < (EntityHandle)alive.size() && alive[handle];
+    }
+
+    /**
+     * @brief Getter for the behaviour attached to an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the attached behaviour, or a null pointer if there is none
+     */
+    Entity *getEntity(EntityHandle handle) const {
+        return behaviours[handle];
+    }
+
+    /**
+     * @brief Getter for the x coordinate of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the x coordinate
+     */
+    float getX(EntityHandle handle) const {
+        return x[handle];
+    }
+
+    /**
+     * @brief Getter for the y coordinate of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the y coordinate
+     */
+    float getY(EntityHandle handle) const {
+        return y[handle];
+    }
+
+    /**
+     * @brief Getter for the x velocity of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the x velocity
+     */
+    float getXVelocity(EntityHandle handle) const {
+        return xVelocity[handle];
+    }
+
+    /**
+     * @brief Getter for the y velocity of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the y velocity
+     */
+    float getYVelocity(EntityHandle handle) const {
+        return yVelocity[handle];
+    }
+
+    /**
+     * @brief Getter for the width of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the width
+     */
+    float getWidth(EntityHandle handle) const {
+        return width[handle];
+    }
+
+    /**
+     * @brief Getter for the height of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the height
+     */
+    float getHeight(EntityHandle handle) const {
+        return height[handle];
+    }
+
+    /**
+     * @brief Getter for the time an entity has remaining in the current tick.
+     *
+     * @param handle the handle of the entity
+     * @return the remaining time, in ticks
+     */
+    float getRemainingTime(EntityHandle handle) const {
+        return remainingTime[handle];
+    }
+
+    /**
+     * @brief Getter for the glyph of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the glyph id
+     */
+    GlyphId getGlyph(EntityHandle handle) const {
+        return glyph[handle];
+    }
+
+    /**
+     * @brief Getter for the colour of an entity.
+     *
+     * @param handle the handle of the entity
+     * @return the colour
+     */
+    Colour getColour(EntityHandle handle) const {
+        return colour[handle];
+    }
+
+    /**
+     * @brief Getter for the bounding box of an entity, which is centred on its coordinates.
+     *
+     * @param handle the handle of the entity
+     * @return the bounding box
+     */
+    Bounds getBounds(EntityHandle handle) const {
+        return {x[handle] - width[handle] / 2, y[handle] - height[handle] / 2, x[handle] + width[handle] / 2,
+                y[handle] + height[handle] / 2};
+    }
+
+    /**
+     * @brief Setter for the x coordinate of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new x coordinate
+     */
+    void setX(EntityHandle handle, float value) {
+        x[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the y coordinate of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new y coordinate
+     */
+    void setY(EntityHandle handle, float value) {
+        y[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the x velocity of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new x velocity
+     */
+    void setXVelocity(EntityHandle handle, float value) {
+        xVelocity[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the y velocity of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new y velocity
+     */
+    void setYVelocity(EntityHandle handle, float value) {
+        yVelocity[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the width of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new width
+     */
+    void setWidth(EntityHandle handle, float value) {
+        width[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the height of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new height
+     */
+    void setHeight(EntityHandle handle, float value) {
+        height[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the glyph of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new glyph id
+     */
+    void setGlyph(EntityHandle handle, GlyphId value) {
+        glyph[handle] = value;
+    }
+
+    /**
+     * @brief Setter for the colour of an entity.
+     *
+     * @param handle the handle of the entity
+     * @param value the new colour
+     */
+    void setColour(EntityHandle handle, Colour value) {
+        colour[handle] = value;
+    }
+};
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * File contains definition of `FrameBuffer` class with appropriate static helper functions.
+ *
+ * @file FrameBuffer.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include "FrameBuffer.h"
+
+const Cell FrameBuffer::EMPTY_CELL = {' ', Colour::TERMINAL_DEFAULT};
+
+/**
+ * @brief Compares two cells for equality.
+ *
+ * @param lhs the first cell
+ * @param rhs the second cell
+ * @return true if both the glyph and colour of the cells are equal
+ */
+bool operator==(const Cell &lhs, const Cell &rhs) {
+    return lhs.glyph == rhs.glyph && lhs.colour == rhs.colour;
+}
+
+/**
+ * @brief Compares two cells for inequality.
+ *
+ * @param lhs the first cell
+ * @param rhs the second cell
+ * @return true if either the glyph or colour of the cells differ
+ */
+bool operator!=(const Cell &lhs, const Cell &rhs) {
+    return !(lhs == rhs);
+}
+
+/**
+ * @brief Static helper function gets the length of the UTF-8 sequence with the given lead byte.
+ *
+ * Malformed lead bytes are treated as single byte sequences.
+ *
+ * @param lead the first byte of the sequence
+ * @return the number of bytes in the sequence
+ */
+static size_t sequenceLength(unsigned char lead) {
+    if ((lead & 0xE0) == 0xC0) {
+        return 2;
+    } else if ((lead & 0xF0) == 0xE0) {
+        return 3;
+    } else if ((lead & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 1;
+}
+
+/**
+ * @brief Default constructor for an empty frame buffer.
+ *
+ * The frame buffer has no cells until it is assigned.
+ */
+FrameBuffer::FrameBuffer() {
+    this->width = 0;
+    this->height = 0;
+}
+
+/**
+ * @brief Constructor for a frame buffer of the given dimensions.
+ *
+ * A single contiguous block of cells is allocated, with every cell initialised to the provided cell.
+ *
+ * @param width the width of the frame buffer
+ * @param height the height of the frame buffer
+ * @param cell the initial value of every cell
+ */
+FrameBuffer::FrameBuffer(int width, int height, const Cell &cell) {
+    this->width = width;
+    this->height = height;
+    this->cells.assign(width * height, cell);
+}
+
+/**
+ * @brief Getter for the width of the frame buffer.
+ *
+ * @return the width of the frame buffer
+ */
+int FrameBuffer::getWidth() const {
+    return width;
+}
+
+/**
+ * @brief Getter for the height of the frame buffer.
+ *
+ * @return the height of the frame buffer
+ */
+int FrameBuffer::getHeight() const {
+    return height;
+}
+
+/**
+ * @brief Determines whether the frame buffer has any cells.
+ *
+ * @return true if the frame buffer has no cells
+ */
+bool FrameBuffer::empty() const {
+    return cells.empty();
+}
+
+/**
+ * @brief Determines whether the given position lies within the frame buffer.
+ *
+ * @param x the x coordinate of the position
+ * @param y the y coordinate of the position
+ * @return true if the position is within the frame buffer
+ */
+bool FrameBuffer::contains(int x, int y) const {
+    return x >= 0 && x < width && y >= 0 && y < height;
+}
+
+/**
+ * @brief Sets every cell of the frame buffer to the empty cell.
+ */
+void FrameBuffer::clear() {
+    fill(EMPTY_CELL);
+}
+
+/**
+ * @brief Sets every cell of the frame buffer to the provided cell.
+ *
+ * @param cell the new value of every cell
+ */
+void FrameBuffer::fill(const Cell &cell) {
+    std::fill(cells.begin(), cells.end(), cell);
+}
+
+/**
+ * @brief Sets every cell in the given rectangle to the provided cell.
+ *
+ * The rectangle is clipped to the bounds of the frame buffer.
+ *
+ * @param x the x coordinate of the left of the rectangle
+ * @param y the y coordinate of the top of the rectangle
+ * @param fillWidth the width of the rectangle
+ * @param fillHeight the height of the rectangle
+ * @param cell the new value of the cells within the rectangle
+ */
+void FrameBuffer::fill(int x, int y, int fillWidth, int fillHeight, const Cell &cell) {
+    int left = std::max(x, 0);
+    int right = std::min(x + fillWidth, width);
+    int top = std::max(y, 0);
+    int bottom = std::min(y + fillHeight, height);
+    for (int row = top; row < bottom; row++) {
+        std::fill(this->row(row) + left, this->row(row) + right, cell);
+    }
+}
+
+/**
+ * @brief Copies the cells of another frame buffer into this frame buffer at the given position.
+ *
+ * The source is clipped to the bounds of this frame buffer, with each row copied as a single block.
+ *
+ * @param source the frame buffer to be copied
+ * @param x the x coordinate at which the left of the source is placed
+ * @param y the y coordinate at which the top of the source is placed
+ */
+void FrameBuffer::blit(const FrameBuffer &source, int x, int y) {
+    int left = std::max(x, 0);
+    int right = std::min(x + source.width, width);
+    int top = std::max(y, 0);
+    int bottom = std::min(y + source.height, height);
+    if (left >= right) {
+        return;
+    }
+    for (int row = top; row < bottom; row++) {
+        std::memcpy(this->row(row) + left, source.row(row - y) + (left - x), (right - left) * sizeof(Cell));
+    }
+}
+
+/**
+ * @brief Writes a line of text into the frame buffer, one character per cell.
+ *
+ * The text is split into UTF-8 encoded characters and written from left to right starting at the given position. ASCII
+ * characters are used as glyph ids directly, while other characters are interned. Characters falling outside of the
+ * frame buffer are clipped.
+ *
+ * @param x the x coordinate of the first character
+ * @param y the y coordinate of the text
+ * @param text the UTF-8 encoded text to be written
+ * @param colour the colour of the text
+ */
+void FrameBuffer::write(int x, int y, const std::string &text, Colour colour) {
+    size_t index = 0;
+    for (int column = x; index < text.length(); column++) {
+        auto lead = (unsigned char)text[index];
+        size_t length = sequenceLength(lead);
+        if (contains(column, y)) {
+            GlyphId glyph = lead < ASCII_GLYPHS
+                            ? lead : GlyphTable::getInstance().intern(std::string_view(text).substr(index, length));
+            at(column, y) = {glyph, colour};
+        }
+        index += length;
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * File contains declaration for `FrameBuffer` class and the `Cell` structure it stores.
+ *
+ * @file FrameBuffer.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <string>
+#include <vector>
+#include "Colour.h"
+#include "GlyphTable.h"
+
+/**
+ * @brief Declaration of `Cell` structure.
+ *
+ * A single position on the game board: the `GlyphTable` id of the character displayed and its colour.
+ */
+struct Cell {
+    GlyphId glyph;
+    Colour colour;
+};
+
+bool operator==(const Cell &lhs, const Cell &rhs);
+
+bool operator!=(const Cell &lhs, const Cell &rhs);
+
+/**
+ * @brief Declaration for `FrameBuffer` class.
+ *
+ * Class provides a fixed size grid of cells stored contiguously in row-major order. As cells are trivially copyable,
+ * copying a frame buffer of equal dimensions is a single block copy. Writes which fall outside of the grid are clipped.
+ */
+class FrameBuffer {
+private:
+    int width;
+    int height;
+    std::vector<Cell> cells;
+
+public:
+    static const Cell EMPTY_CELL;
+
+    FrameBuffer();
+
+    FrameBuffer(int width, int height, const Cell &cell = EMPTY_CELL);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    bool empty() const;
+
+    bool contains(int x, int y) const;
+
+    Cell &at(int x, int y) {
+        return cells[y * width + x];
+    }
+
+    const Cell &at(int x, int y) const {
+        return cells[y * width + x];
+    }
+
+    Cell *row(int y) {
+        return cells.data() + y * width;
+    }
+
+    const Cell *row(int y) const {
+        return cells.data() + y * width;
+    }
+
+    void clear();
+
+    void fill(const Cell &cell);
+
+    void fill(int x, int y, int fillWidth, int fillHeight, const Cell &cell);
+
+    void blit(const FrameBuffer &source, int x, int y);
+
+    void write(int x, int y, const std::string &text, Colour colour);
+};
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * File contains definition of `FrameScheduler` class.
+ *
+ * @file FrameScheduler.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include "FrameScheduler.h"
+
+/**
+ * @brief Constructor for a new scheduler with the given tick and frame lengths.
+ *
+ * The first tick and frame are due one tick length and one frame length from construction respectively.
+ *
+ * @param tickLength the time between simulation ticks
+ * @param frameLength the time between rendered frames
+ * @param maxCatchUpTicks the maximum number of late ticks which may be run in succession before ticks are dropped
+ */
+FrameScheduler::FrameScheduler(timer::duration tickLength, timer::duration frameLength, int maxCatchUpTicks) {
+    this->tickLength = tickLength;
+    this->frameLength = frameLength;
+    this->maxCatchUpTicks = maxCatchUpTicks;
+    this->overrunCount = 0;
+    this->droppedTickCount = 0;
+    reset();
+}
+
+/**
+ * @brief Restarts the schedule from the current time.
+ *
+ * Any accumulated time is discarded. This should be called after the game loop has been blocked, for example by a
+ * menu, so that the time spent blocked is not caught up.
+ */
+void FrameScheduler::reset() {
+    accumulator = timer::duration::zero();
+    lastUpdate = timer::now();
+    nextFrame = lastUpdate + frameLength;
+}
+
+/**
+ * @brief Sleeps until the next tick or frame is due, then updates the accumulated time.
+ */
+void FrameScheduler::waitForNextDeadline() {
+    sleepUntil(getNextDeadline());
+    update();
+}
+
+/**
+ * @brief Adds the time elapsed since the last update to the accumulated time.
+ *
+ * An overrun is recorded if more than one tick is owed. If more than the maximum number of catch-up ticks are owed, the
+ * surplus is discarded and recorded as dropped ticks.
+ */
+void FrameScheduler::update() {
+    timer::time_point now = timer::now();
+    accumulator += now - lastUpdate;
+    lastUpdate = now;
+    if (accumulator >= 2 * tickLength) {
+        overrunCount++;
+    }
+    if (accumulator > maxCatchUpTicks * tickLength) {
+        droppedTickCount += (accumulator - maxCatchUpTicks * tickLength) / tickLength;
+        accumulator = maxCatchUpTicks * tickLength;
+    }
+}
+
+/**
+ * @brief Determines whether a simulation tick is due, consuming one tick of accumulated time if so.
+ *
+ * This should be called in a loop after each update, running one tick each time it returns true.
+ *
+ * @return true if a tick should be run
+ */
+bool FrameScheduler::tickDue() {
+    if (accumulator < tickLength) {
+        return false;
+    }
+    accumulator -= tickLength;
+    return true;
+}
+
+/**
+ * @brief Determines whether a frame is due to be rendered, scheduling the next frame if so.
+ *
+ * If frames have been missed, the next frame is scheduled one frame length from now rather than catching up.
+ *
+ * @return true if a frame should be rendered
+ */
+bool FrameScheduler::frameDue() {
+    if (lastUpdate < nextFrame) {
+        return false;
+    }
+    nextFrame += frameLength;
+    if (nextFrame <= lastUpdate) {
+        nextFrame = lastUpdate + frameLength;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the time at which the next tick or frame is due, whichever is sooner.
+ *
+ * @return the time of the next deadline
+ */
+FrameScheduler::timer::time_point FrameScheduler::getNextDeadline() const {
+    return std::min(lastUpdate + (tickLength - accumulator), nextFrame);
+}
+
+/**
+ * @brief Getter for the number of times the scheduler woke more than one tick late.
+ *
+ * @return the number of overruns
+ */
+long FrameScheduler::getOverrunCount() const {
+    return overrunCount;
+}
+
+/**
+ * @brief Getter for the number of ticks dropped because too many ticks were owed.
+ *
+ * @return the number of dropped ticks
+ */
+long FrameScheduler::getDroppedTickCount() const {
+    return droppedTickCount;
+}
+
+/**
+ * @brief Sleeps the calling thread until the given time.
+ *
+ * The sleep is made against an absolute time on the monotonic clock, which the steady clock is based on, so that
+ * interruptions and scheduling delays do not accumulate drift.
+ *
+ * @param deadline the time to sleep until
+ */
+void FrameScheduler::sleepUntil(timer::time_point deadline) {
+    struct timespec wakeTime = toTimespec(deadline);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, nullptr) == EINTR);
+}
+
+/**
+ * @brief Converts a steady clock time to an absolute time on the monotonic clock.
+ *
+ * @param time the time to be converted
+ * @return the equivalent `timespec`, for use with `CLOCK_MONOTONIC`
+ */
+struct timespec FrameScheduler::toTimespec(timer::time_point time) {
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    struct timespec converted{};
+    converted.tv_sec = sinceEpoch / 1000000000;
+    converted.tv_nsec = sinceEpoch % 1000000000;
+    return converted;
+}
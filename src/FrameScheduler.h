@@ -0,0 +1,64 @@
+/**
+ * File contains declaration for `FrameScheduler` class.
+ *
+ * @file FrameScheduler.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <chrono>
+#include <ctime>
+
+/**
+ * @brief Declaration for `FrameScheduler` class.
+ *
+ * Class provides a fixed-timestep scheduler for game loops. Simulation ticks run at a fixed rate, with the time elapsed
+ * between wake-ups accumulated and consumed one tick at a time so that late ticks are caught up. Frames are rendered at
+ * an independent rate and are never caught up; late frames are skipped. Between deadlines, the calling thread sleeps
+ * until an absolute time on the monotonic clock rather than spinning.
+ *
+ * An overrun is recorded whenever the scheduler wakes more than one tick late. If more ticks are owed than may be
+ * caught up at once, the surplus ticks are dropped and counted.
+ */
+class FrameScheduler {
+public:
+    using timer = std::chrono::steady_clock;
+
+private:
+    timer::duration tickLength;
+    timer::duration frameLength;
+    int maxCatchUpTicks;
+    timer::duration accumulator;
+    timer::time_point lastUpdate;
+    timer::time_point nextFrame;
+    long overrunCount;
+    long droppedTickCount;
+
+public:
+    FrameScheduler(timer::duration tickLength, timer::duration frameLength, int maxCatchUpTicks);
+
+    void reset();
+
+    void waitForNextDeadline();
+
+    void update();
+
+    bool tickDue();
+
+    bool frameDue();
+
+    timer::time_point getNextDeadline() const;
+
+    long getOverrunCount() const;
+
+    long getDroppedTickCount() const;
+
+    static void sleepUntil(timer::time_point deadline);
+
+    static struct timespec toTimespec(timer::time_point time);
+};
+
+#endif
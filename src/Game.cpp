@@ -7,63 +7,129 @@
  */
 
 #include "Game.h"
-#include "InputWatcher.h"
 #include <iostream>
 
 /**
  * @brief Basic base constructor
  *
- * Constructs new instance with the provided renderer, defaulting the active game status to true.
+ * Constructs new instance with the provided renderer and input source, defaulting the active game status to true. The
+ * broadphase grid covers a board of the size provided by the renderer. The score recorder does not open its file until
+ * it is used.
  *
  * @param renderer the instance of `Renderer` to be used to display the game
+ * @param input the instance of `InputSource` the game's input is read from
  * @param filename the file name of the game's high scores file
  * @param maxScore the maximum score of the game
  * @param maxTime the maximum time of the game
  */
-Game::Game(Renderer *renderer, const std::string &filename, int maxScore, int maxTime) {
+Game::Game(Renderer *renderer, InputSource *input, const std::string &filename, int maxScore, int maxTime)
+        : scoreRecorder(filename) {
     this->renderer = renderer;
-    this->scoreRecorder = new ScoreRecorder(filename);
+    this->input = input;
     this->maxScore = maxScore;
     this->maxTime = maxTime;
+    this->grid = SpatialGrid(renderer->getWidth(), renderer->getHeight());
     gameFinished = false;
     gamePaused = false;
     tickCount = 0;
+    stats = nullptr;
+    statsOverlay = false;
 }
 
 /**
  * @brief Default destructor.
  *
- * Destroys the score recorder.
+ * Every entity in the game is destroyed along with the arena it was created in.
  */
-Game::~Game() {
-    delete scoreRecorder;
+Game::~Game() = default;
+
+/**
+ * @brief Adds an entity to the game under the provided name, and to the broadphase grid.
+ *
+ * The entity must have been created in the registry and the arena of the game, and is destroyed with the game.
+ *
+ * @param name the name of the entity
+ * @param entity the entity to add
+ * @return the handle of the entity
+ */
+EntityHandle Game::addEntity(const std::string &name, Entity *entity) {
+    registry.setName(entity->getHandle(), name);
+    grid.insert(entity);
+    return entity->getHandle();
+}
+
+/**
+ * @brief Destroys every entity in the game, ready for the entities of a new match to be added.
+ *
+ * The arena is rewound rather than released, so the new entities reuse the memory of the old ones, and the registry
+ * and broadphase grid are emptied without releasing their storage.
+ */
+void Game::clearEntities() {
+    arena.reset();
+    registry.clear();
+    grid.clear();
+}
+
+/**
+ * @brief Composes the frame to be displayed from the state of the game.
+ *
+ * By default, the game board is displayed as it is. Games which draw their entities only when a frame is displayed
+ * override this.
+ *
+ * @return the frame to be displayed, valid until the next call
+ */
+const FrameBuffer &Game::composeFrame() {
+    return gameBoard;
+}
+
+/**
+ * @brief Composes and displays a frame, timing each as a phase if the game is timed.
+ */
+void Game::drawFrame() {
+    const FrameBuffer *composed;
+    {
+        GameStats::ScopedTimer timer(stats, Phase::COMPOSE);
+        composed = &composeFrame();
+    }
+    GameStats::ScopedTimer timer(stats, Phase::RENDER);
+    renderer->draw(*composed);
+}
+
+/**
+ * @brief Times the phases of the game loop from now on.
+ *
+ * @param stats the timings the phases are recorded to, which must outlive the game, or nullptr to stop timing
+ * @param overlay whether the timings are drawn over the game board, if the game supports it
+ */
+void Game::setStats(GameStats *stats, bool overlay) {
+    this->stats = stats;
+    this->statsOverlay = overlay && stats != nullptr;
 }
 
 /**
  * @brief General exit menu.
  *
- * Constructs an exit menu that can be called with the push of the key p.
+ * Constructs an exit menu that can be called with the push of the escape key. If the input source is exhausted, the
+ * game is exited.
  */
 void Game::exitMenu() {
     renderer->displayMenu("Game paused, do you wish to continue?",
                           {"Yes, resume!", "No, exit - all of your progress will be lost"});
-    char input;
+    char key;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            switch (input) {
-                case '1':
-                    gamePaused = false;
-                    break;
-                case '2':
-                    gameFinished = true;
-                    break;
-                default:
-                    continue;
-            }
-        }
-        if (input == '1' || input == '2') {
-            break;
+        key = input->waitForKey();
+        switch (key) {
+            case '\0':
+            case '2':
+                gameFinished = true;
+                break;
+            case '1':
+                gamePaused = false;
+                break;
+            default:
+                continue;
         }
+        break;
     }
 }
 
@@ -71,23 +137,25 @@ void Game::exitMenu() {
 void Game::registerHighScore(int playerNo) {
     displayMessage("Congratulations player " + std::to_string(playerNo) + ", you win!", -6);
     displayMessage("Enter a 3 letter name to register your score:", -4);
-    renderer->draw(gameBoard);
+    renderer->draw(composeFrame());
     std::string result;
-    char input;
+    char key;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            if (input >= 'a' && input <= 'z') {
-                input -= 32;
-                result.append(std::string{input});
-                displayMessage(result, -3);
-                renderer->draw(gameBoard);
-                if (result.length() == 3) {
-                    break;
-                }
+        key = input->waitForKey();
+        if (key == '\0') {
+            return;  // input source exhausted, no name can be entered.
+        }
+        if (key >= 'a' && key <= 'z') {
+            key -= 32;
+            result.append(std::string{key});
+            displayMessage(result, -3);
+            renderer->draw(composeFrame());
+            if (result.length() == 3) {
+                break;
             }
         }
     }
-    if (scoreRecorder->writeScore(result, maxScore)) {
+    if (scoreRecorder.writeScore(result, maxScore)) {
         displayMessage("Your score has been registered, " + result + "!", -2);
     } else {
         displayMessage("Your score was unable to be recorded due to an unforeseen error", -2);
@@ -95,10 +163,26 @@ void Game::registerHighScore(int playerNo) {
 }
 
 void Game::displayMessage(const std::string &message, int displacement) {
-    int midX = gameBoard[0].size() / 2;
-    int midY = gameBoard.size() / 2;
+    int midX = gameBoard.getWidth() / 2;
+    int midY = gameBoard.getHeight() / 2;
     int strMid = message.length() / 2;
-    for (int i = 0; i < message.length(); i++) {
-        gameBoard[midY + displacement][midX - strMid + i] = std::make_pair(message[i], Colour::TERMINAL_DEFAULT);
-    }
+    gameBoard.write(midX - strMid, midY + displacement, message, Colour::TERMINAL_DEFAULT);
+}
+
+/**
+ * @brief Determines whether the game has finished.
+ *
+ * @return true if the game has finished
+ */
+bool Game::isFinished() const {
+    return gameFinished;
+}
+
+/**
+ * @brief Getter for the number of ticks run.
+ *
+ * @return the number of ticks run
+ */
+int Game::getTickCount() const {
+    return tickCount;
 }
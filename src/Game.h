@@ -11,9 +11,12 @@
 
 #include <vector>
 #include <map>
-#include "Entity.h"
+#include "Arena.h"
+#include "SpatialGrid.h"
 #include "renderer/Renderer.h"
 #include "ScoreRecorder.h"
+#include "InputSource.h"
+#include "GameStats.h"
 
 /**
  * @brief Declaration for abstract `Game` class.
@@ -24,19 +27,30 @@
 class Game {
 protected:
     Renderer *renderer;
-    ScoreRecorder *scoreRecorder;
+    InputSource *input;
+    ScoreRecorder scoreRecorder;
     int maxScore;
     int maxTime;
-    std::map<std::string, Entity *> entities;
-    std::vector<std::vector<std::pair<std::string, Colour>>> gameBoard;
+    EntityRegistry registry;
+    SpatialGrid grid;
+    Arena arena;  // declared after the registry, so that entities are destroyed before it.
+    FrameBuffer gameBoard;
     bool gameFinished;
     bool gamePaused;
     int tickCount;
+    GameStats *stats;
+    bool statsOverlay;
 
     virtual void tick() = 0;
 
+    void drawFrame();
+
+    EntityHandle addEntity(const std::string &name, Entity *entity);
+
+    void clearEntities();
+
 public:
-    explicit Game(Renderer *renderer, const std::string &filename, int maxScore, int maxTime);
+    Game(Renderer *renderer, InputSource *input, const std::string &filename, int maxScore, int maxTime);
 
     virtual ~Game() = 0;
 
@@ -48,6 +62,14 @@ public:
 
     virtual void runGameLoop() = 0;
 
+    virtual const FrameBuffer &composeFrame();
+
+    void setStats(GameStats *stats, bool overlay);
+
+    bool isFinished() const;
+
+    int getTickCount() const;
+
 };
 
 #endif
@@ -6,19 +6,37 @@
  * @date 05/11/21
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include "InputWatcher.h"
+#include "ReplayInputSource.h"
+#include "TraceWriter.h"
 #include "renderer/ConsoleRenderer.h"
 #include "renderer/DotMatrixRenderer.h"
+#include "renderer/NullRenderer.h"
+#include "renderer/SharedMemoryRenderer.h"
+#include "renderer/ThreadedRenderer.h"
 #include "pong/Pong.h"
+#include "pong/PongReplay.h"
 
 #define BOARD_WIDTH 101
 #define BOARD_HEIGHT 31
+#define DOT_MATRIX_DEVICE_VARIABLE "DOT_MATRIX_DEVICE"  // environment variable overriding the dot matrix device.
 
 int pongMaxScore = 5;
 int pongMaxTime = 2;  // minutes.
+std::string recordingPath;  // file each game of Pong is recorded to, if not empty.
+PaddleAI pongAIMode = PaddleAI::TRACKING;  // how the AI paddles of each game of Pong choose where to move.
+int pongTickRate = BASE_TICK_RATE;  // ticks per second.
+int pongBallSpeed = BASE_TICK_RATE;  // cells per second.
+int pongSpeedRamp = 0;  // percent per paddle hit.
+GameStats *gameStats = nullptr;  // timings of the game loop of every game played, if they are collected.
+bool statsOverlay = false;  // whether the timings are drawn over each game.
 
 /**
  * @brief Static helper function gets new settings numerical value.
@@ -34,13 +52,12 @@ int getNewValue(Renderer *renderer) {
     std::string result = "0";
     char input;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            if (input >= '0' && input <= '9') {
-                std::cout << input << std::flush;
-                result.append(std::string{input});
-            } else if (input == '\n') {
-                return std::stoi(result);
-            }
+        input = InputWatcher::getInstance().waitForKey();
+        if (input >= '0' && input <= '9') {
+            std::cout << input << std::flush;
+            result.append(std::string{input});
+        } else if (input == '\n') {
+            return std::stoi(result);
         }
     }
 }
@@ -48,7 +65,8 @@ int getNewValue(Renderer *renderer) {
 /**
  * @brief Static helper function displays the settings menu.
  *
- * Allows the user to set the maximum score and time for each game.
+ * Allows the user to set the maximum score and time for each game, and the tick rate, ball speed and speed ramp of
+ * Pong. The tick rate and ball speed are clamped to the ranges the game supports.
  *
  * @param renderer the renderer to display the menu
  */
@@ -58,28 +76,45 @@ void displaySettings(Renderer *renderer) {
                           "record your high score!";
     std::vector<std::string> options = {"Pong Maximum Game Score = " + std::to_string(pongMaxScore),
                                         "Pong Maximum Game Duration = " + std::to_string(pongMaxTime),
+                                        "Pong Tick Rate (ticks per second) = " + std::to_string(pongTickRate),
+                                        "Pong Ball Speed (cells per second) = " + std::to_string(pongBallSpeed),
+                                        "Pong Speed Ramp (% per return) = " + std::to_string(pongSpeedRamp),
                                         "",
                                         "Return to Main Menu"};
     renderer->displayMenu(message, options);
     char input;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            switch (input) {
-                case '1':
-                    pongMaxScore = getNewValue(renderer);
-                    options[0] = "Pong Maximum Game Score = " + std::to_string(pongMaxScore);
-                    renderer->displayMenu(message, options);
-                    break;
-                case '2':
-                    pongMaxTime = getNewValue(renderer);
-                    options[1] = "Pong Maximum Game Duration = " + std::to_string(pongMaxTime);
-                    renderer->displayMenu(message, options);
-                    break;
-                case '3':
-                    return;
-                default:
-                    continue;
-            }
+        input = InputWatcher::getInstance().waitForKey();
+        switch (input) {
+            case '1':
+                pongMaxScore = getNewValue(renderer);
+                options[0] = "Pong Maximum Game Score = " + std::to_string(pongMaxScore);
+                renderer->displayMenu(message, options);
+                break;
+            case '2':
+                pongMaxTime = getNewValue(renderer);
+                options[1] = "Pong Maximum Game Duration = " + std::to_string(pongMaxTime);
+                renderer->displayMenu(message, options);
+                break;
+            case '3':
+                pongTickRate = std::clamp(getNewValue(renderer), MIN_TICK_RATE, MAX_TICK_RATE);
+                options[2] = "Pong Tick Rate (ticks per second) = " + std::to_string(pongTickRate);
+                renderer->displayMenu(message, options);
+                break;
+            case '4':
+                pongBallSpeed = std::clamp(getNewValue(renderer), MIN_BALL_SPEED, MAX_BALL_SPEED);
+                options[3] = "Pong Ball Speed (cells per second) = " + std::to_string(pongBallSpeed);
+                renderer->displayMenu(message, options);
+                break;
+            case '5':
+                pongSpeedRamp = getNewValue(renderer);
+                options[4] = "Pong Speed Ramp (% per return) = " + std::to_string(pongSpeedRamp);
+                renderer->displayMenu(message, options);
+                break;
+            case '6':
+                return;
+            default:
+                continue;
         }
     }
 }
@@ -98,13 +133,12 @@ std::string selectHighScoresGame(Renderer *renderer) {
     renderer->displayMenu(message, options);
     char input;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            switch (input) {
-                case '1':
-                    return "pong";
-                default:
-                    continue;
-            }
+        input = InputWatcher::getInstance().waitForKey();
+        switch (input) {
+            case '1':
+                return "pong";
+            default:
+                continue;
         }
     }
 }
@@ -118,10 +152,10 @@ std::string selectHighScoresGame(Renderer *renderer) {
  */
 void displayHighScores(Renderer *renderer) {
     std::string filename = selectHighScoresGame(renderer);
-    ScoreRecorder *scoreRecorder = new ScoreRecorder("pong");
+    ScoreRecorder scoreRecorder("pong");
     filename[0] = toupper(filename[0]);
     renderer->displayMessage(filename + " high scores:\n", true);
-    std::vector<std::string> lines = scoreRecorder->getHighScores(5);
+    std::vector<std::string> lines = scoreRecorder.getHighScores(5);
     int lineCount = 0;
     for (std::string line: lines) {
         if (line.length() > 0) {
@@ -133,14 +167,15 @@ void displayHighScores(Renderer *renderer) {
         renderer->displayMessage("No scores to display", false);
     }
     renderer->displayMessage("\nPress any key to return to the main menu", false);
-    while (InputWatcher::getInstance().getKeyPress() == '\0');
-    delete scoreRecorder;
+    InputWatcher::getInstance().waitForKey();
 }
 
 /**
  * @brief Gets desired output method for user.
  *
- * Prompts user to select output method and returns appropriate instance of abstract superclass `Renderer`.
+ * Prompts user to select output method and returns appropriate instance of abstract superclass `Renderer`. The dot
+ * matrix is written to the framebuffer device named by the `DOT_MATRIX_DEVICE` environment variable, or `/dev/fb0` by
+ * default, and the command line is used instead if the device cannot be opened.
  *
  * @param width the width of the display
  * @param height the height of the display
@@ -162,7 +197,14 @@ Renderer *selectOutput(int width, int height) {
     if (user_selection == "1") {
         return new ConsoleRenderer(width, height);
     }
-    return new DotMatrixRenderer(width, height);
+    const char *device = std::getenv(DOT_MATRIX_DEVICE_VARIABLE);
+    try {
+        return new DotMatrixRenderer(width, height, device != nullptr ? device : DEFAULT_DOT_MATRIX_DEVICE);
+    } catch (const std::runtime_error &error) {
+        std::cout << std::endl << "Unable to open the dot matrix (" << error.what() << "), using the command line."
+                  << std::endl;
+        return new ConsoleRenderer(width, height);
+    }
 }
 
 /**
@@ -180,46 +222,206 @@ Game *selectGame(Renderer *renderer) {
     renderer->displayMenu(message, options);
     char input;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            switch (input) {
-                case '1':
-                    return new Pong(renderer, pongMaxScore, pongMaxTime);
-                case '2':
-                    displayHighScores(renderer);
-                    renderer->displayMenu(message, options);
-                    continue;
-                case '3':
-                    displaySettings(renderer);
-                    renderer->displayMenu(message, options);
-                    continue;
-                case '4':
-                    return nullptr;
-                default:
-                    continue;
+        input = InputWatcher::getInstance().waitForKey();
+        switch (input) {
+            case '1':
+            {
+                PongConfig config = Pong::promptForConfig(renderer, pongMaxScore, pongMaxTime, pongAIMode);
+                config.tickRate = pongTickRate;
+                config.ballSpeed = pongBallSpeed;
+                config.speedRamp = pongSpeedRamp;
+                Pong *pong = new Pong(renderer, config, &InputWatcher::getInstance());
+                if (!recordingPath.empty()) {
+                    pong->startRecording(recordingPath);
+                }
+                return pong;
             }
+            case '2':
+                displayHighScores(renderer);
+                renderer->displayMenu(message, options);
+                continue;
+            case '3':
+                displaySettings(renderer);
+                renderer->displayMenu(message, options);
+                continue;
+            case '4':
+                return nullptr;
+            default:
+                continue;
         }
     }
 }
 
+/**
+ * @brief Replays a recorded game of Pong as a headless game, as fast as possible, and checks it against the recording.
+ *
+ * No terminal is needed, as the game is given only the recorded input and is displayed by a `NullRenderer`. The replay
+ * is exact if it lasts the same number of ticks as the recording and finishes in the same state.
+ *
+ * If timings are being collected, the replay is timed, and they are printed once it has finished.
+ *
+ * @param path the path of the recording
+ * @return 0 if the replay was exact, or 1 if it was not or the recording could not be read
+ */
+int replayGame(const std::string &path) {
+    PongReplay replay;
+    if (!replay.load(path)) {
+        std::cerr << path << ": unable to read the recording" << std::endl;
+        return 1;
+    }
+    if (replay.tickCount == 0) {
+        std::cout << "The recording has no ticks to replay." << std::endl;
+        return 0;
+    }
+    NullRenderer renderer(replay.width, replay.height);
+    ReplayInputSource input(replay.inputs);
+    PongConfig config = replay.config;
+    config.headless = true;
+    config.maxTicks = replay.tickCount;
+
+    auto start = std::chrono::steady_clock::now();
+    Pong pong(&renderer, config, &input);
+    pong.setStats(gameStats, false);
+    pong.runGameLoop();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double gameSeconds = pong.getElapsedSeconds();
+    std::cout << "Replayed " << pong.getTickCount() << " ticks (" << gameSeconds << " s of play) in "
+              << seconds * 1000.0 << " ms, " << gameSeconds / seconds << "x real time." << std::endl;
+    if (pong.getTickCount() != (int)replay.tickCount || pong.getStateHash() != replay.stateHash) {
+        std::cout << "The replay diverged from the recording: expected " << replay.tickCount << " ticks with state "
+                  << std::hex << replay.stateHash << ", but finished with state " << pong.getStateHash() << std::dec
+                  << "." << std::endl;
+        return 1;
+    }
+    std::cout << "Final scores " << pong.getScore(0) << " - " << pong.getScore(1)
+              << ", matching the recording exactly." << std::endl;
+    if (gameStats != nullptr) {
+        std::cout << std::endl;
+        gameStats->print(std::cout);
+    }
+    return 0;
+}
+
+/**
+ * @brief Stops the trace, if one is being written, and reports how many events it holds.
+ *
+ * @return true if no trace was being written or the whole trace was written, false if it could not be written
+ */
+bool stopTrace() {
+    if (!TraceWriter::isEnabled()) {
+        return true;
+    }
+    if (!TraceWriter::stop()) {
+        std::cerr << "Unable to write the trace" << std::endl;
+        return false;
+    }
+    std::cout << "Traced " << TraceWriter::getWrittenCount() << " events";
+    if (TraceWriter::getDroppedCount() > 0) {
+        std::cout << ", dropping " << TraceWriter::getDroppedCount() << " while buffers were full";
+    }
+    std::cout << "." << std::endl;
+    return true;
+}
+
 /**
  * @brief Main function executes program.
  *
  * Initialises a new instance of `Renderer` and `Game` based on the user's selections and runs the game loop of the game
  * selected.
  *
- * @return 0 on successful execution
+ * With the `--threaded-render` option, frames are drawn on a separate render thread, so that a slow terminal or
+ * display does not hold up the game. With the `--export-shm` option, every frame is also exported through the named
+ * POSIX shared memory region, for other processes to display or record.
+ *
+ * With the `--record` option, each game of Pong played is recorded to the named file, overwriting the previous game.
+ * With the `--replay` option, the recorded game in the named file is replayed without a display, and no game is played.
+ * With the `--predictive-ai` option, AI paddles predict where the ball will reach them rather than following it.
+ * With the `--stats` option, the phases of the game loop of every game are timed, and the 50th and 99th percentile and
+ * maximum of each are printed on exit. With the `--stats-overlay` option, they are also drawn over each game. With the
+ * `--trace` option, a trace of the game loop, rendering, input and high score file access is written to the named file
+ * in the Chrome trace event format, until the program exits.
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return 0 on successful execution, or 1 if an argument is not recognised, the frames cannot be exported, the trace
+ * cannot be written or a replay was not exact
  */
-int main() {
+int main(int argc, char *argv[]) {
+    bool threadedRender = false;
+    std::string exportName;
+    std::string replayPath;
+    bool collectStats = false;
+    std::string tracePath;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--threaded-render") {
+            threadedRender = true;
+        } else if (argument == "--export-shm" && i + 1 < argc) {
+            exportName = argv[++i];
+        } else if (argument == "--record" && i + 1 < argc) {
+            recordingPath = argv[++i];
+        } else if (argument == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (argument == "--predictive-ai") {
+            pongAIMode = PaddleAI::PREDICTIVE;
+        } else if (argument == "--stats") {
+            collectStats = true;
+        } else if (argument == "--stats-overlay") {
+            collectStats = true;
+            statsOverlay = true;
+        } else if (argument == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--threaded-render] [--export-shm NAME] [--record FILE]"
+                      << " [--replay FILE] [--predictive-ai] [--stats] [--stats-overlay]"
+                      << " [--trace FILE]" << std::endl;
+            return 1;
+        }
+    }
+    GameStats stats;
+    if (collectStats) {
+        gameStats = &stats;
+    }
+    if (!tracePath.empty()) {
+        if (!TraceWriter::start(tracePath)) {
+            std::cerr << tracePath << ": unable to write the trace" << std::endl;
+            return 1;
+        }
+        TraceWriter::nameThread("game");
+    }
+    if (!replayPath.empty()) {
+        int status = replayGame(replayPath);
+        return stopTrace() ? status : 1;
+    }
     Renderer *renderer = selectOutput(BOARD_WIDTH, BOARD_HEIGHT);
+    if (threadedRender) {
+        renderer = new ThreadedRenderer(renderer);
+    }
+    if (!exportName.empty()) {
+        // Frames are exported on the game thread, so that a slow display does not slow the export.
+        try {
+            renderer = new SharedMemoryRenderer(exportName, renderer);
+        } catch (const std::runtime_error &error) {
+            std::cerr << "Unable to export frames: " << error.what() << std::endl;
+            delete renderer;
+            return 1;
+        }
+    }
     InputWatcher::getInstance();  // ensure InputWatcher singleton is initialised.
     while (true) {
         Game *game = selectGame(renderer);
         if (game == nullptr) {
             break;
         }
+        game->setStats(gameStats, statsOverlay);
         game->runGameLoop();
         delete game;
     }
     delete renderer;
-    return 0;
+    InputWatcher::destroyInstance();
+    if (gameStats != nullptr) {
+        gameStats->print(std::cout);  // printed once the terminal has been restored.
+    }
+    return stopTrace() ? 0 : 1;
 }
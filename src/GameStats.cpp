@@ -0,0 +1,321 @@
+/**
+ * File contains definitions of the `LatencyHistogram` and `GameStats` classes.
+ *
+ * @file GameStats.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include "GameStats.h"
+
+static const char *const PHASE_NAMES[PHASE_COUNT] = {"input", "update", "compose", "render", "lateness"};
+
+/**
+ * @brief Constructor for a new, empty histogram.
+ */
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+/**
+ * @brief Static helper function finds the bucket a duration is counted in.
+ *
+ * Durations below `SUB_BUCKET_COUNT` have a bucket each. Larger durations are bucketed by their highest set bit and the
+ * `SUB_BUCKET_BITS` bits below it.
+ *
+ * @param nanoseconds the duration
+ * @return the index of the bucket
+ */
+size_t LatencyHistogram::bucketOf(std::uint64_t nanoseconds) {
+    if (nanoseconds < SUB_BUCKET_COUNT) {
+        return (size_t)nanoseconds;
+    }
+    int shift = 63 - __builtin_clzll(nanoseconds) - SUB_BUCKET_BITS;
+    return (size_t)(shift + 1) * SUB_BUCKET_COUNT + (size_t)((nanoseconds >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+/**
+ * @brief Static helper function finds the longest duration counted in a bucket.
+ *
+ * @param bucket the index of the bucket
+ * @return the longest duration of the bucket, in nanoseconds
+ */
+std::uint64_t LatencyHistogram::bucketLimit(size_t bucket) {
+    if (bucket < SUB_BUCKET_COUNT) {
+        return bucket;
+    }
+    size_t shift = bucket / SUB_BUCKET_COUNT - 1;
+    std::uint64_t lowest = (std::uint64_t)(SUB_BUCKET_COUNT + bucket % SUB_BUCKET_COUNT) << shift;
+    return lowest + (((std::uint64_t)1 << shift) - 1);
+}
+
+/**
+ * @brief Counts a duration. May be called by any number of threads at once.
+ *
+ * @param nanoseconds the duration
+ */
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    buckets[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(nanoseconds, std::memory_order_relaxed);
+    std::uint64_t current = maximum.load(std::memory_order_relaxed);
+    while (nanoseconds > current && !maximum.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed));
+}
+
+/**
+ * @brief Empties the histogram. Durations recorded at the same time may be kept in part.
+ */
+void LatencyHistogram::reset() {
+    for (std::atomic<std::uint64_t> &bucket: buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Getter for the number of durations recorded.
+ *
+ * @return the number of durations
+ */
+std::uint64_t LatencyHistogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Getter for the mean duration recorded.
+ *
+ * @return the mean duration in nanoseconds, or 0 if none have been recorded
+ */
+std::uint64_t LatencyHistogram::getMean() const {
+    std::uint64_t recorded = getCount();
+    return recorded == 0 ? 0 : total.load(std::memory_order_relaxed) / recorded;
+}
+
+/**
+ * @brief Getter for the longest duration recorded.
+ *
+ * @return the longest duration in nanoseconds, or 0 if none have been recorded
+ */
+std::uint64_t LatencyHistogram::getMax() const {
+    return maximum.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Finds the duration which the given percentage of the durations recorded are no longer than.
+ *
+ * The duration is the upper limit of the bucket the percentile falls in, so it overstates the true percentile by at
+ * most 12.5%, and is never more than the longest duration recorded.
+ *
+ * @param percentile the percentage, from 0 to 100
+ * @return the duration in nanoseconds, or 0 if none have been recorded
+ */
+std::uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    // The buckets are totalled rather than read from the count, so that the rank is within the snapshot walked.
+    std::uint64_t snapshot[HISTOGRAM_BUCKET_COUNT];
+    std::uint64_t recorded = 0;
+    for (size_t bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; bucket++) {
+        snapshot[bucket] = buckets[bucket].load(std::memory_order_relaxed);
+        recorded += snapshot[bucket];
+    }
+    if (recorded == 0) {
+        return 0;
+    }
+    auto rank = (std::uint64_t)std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * (double)recorded);
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; bucket++) {
+        seen += snapshot[bucket];
+        if (seen >= rank) {
+            return std::min(bucketLimit(bucket), getMax());
+        }
+    }
+    return getMax();
+}
+
+/**
+ * @brief Constructor for `ScopedTimer`, starting the timer if an instance of `GameStats` is provided.
+ *
+ * @param stats the timings the phase is recorded to, or nullptr if it is not timed
+ * @param phase the phase timed
+ */
+GameStats::ScopedTimer::ScopedTimer(GameStats *stats, Phase phase) {
+    this->stats = stats;
+    this->phase = phase;
+    if (stats != nullptr) {
+        start = timer::now();
+    }
+}
+
+/**
+ * @brief Destructor for `ScopedTimer`, recording the time since it was constructed.
+ */
+GameStats::ScopedTimer::~ScopedTimer() {
+    if (stats != nullptr) {
+        stats->record(phase, timer::now() - start);
+    }
+}
+
+/**
+ * @brief Discards the timing, for a phase which was held up by waiting for the user.
+ */
+void GameStats::ScopedTimer::cancel() {
+    stats = nullptr;
+}
+
+/**
+ * @brief Constructor for new, empty timings.
+ */
+GameStats::GameStats() {
+    this->missedDeadlineCount = 0;
+    this->droppedTickCount = 0;
+    this->overlay.reserve(OVERLAY_CAPACITY);
+}
+
+/**
+ * @brief Records the duration of a phase. May be called by any number of threads at once.
+ *
+ * @param phase the phase
+ * @param duration the duration, which is recorded as zero if negative
+ */
+void GameStats::record(Phase phase, timer::duration duration) {
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    histograms[(size_t)phase].record((std::uint64_t)std::max<decltype(nanoseconds)>(nanoseconds, 0));
+}
+
+/**
+ * @brief Adds to the number of deadlines missed and ticks dropped by a game loop.
+ *
+ * @param missed the number of times the game loop woke more than a tick late
+ * @param dropped the number of ticks dropped because too many were owed
+ */
+void GameStats::addMissedDeadlines(long missed, long dropped) {
+    missedDeadlineCount.fetch_add(missed, std::memory_order_relaxed);
+    droppedTickCount.fetch_add(dropped, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Empties every histogram and count.
+ */
+void GameStats::reset() {
+    for (LatencyHistogram &histogram: histograms) {
+        histogram.reset();
+    }
+    missedDeadlineCount.store(0, std::memory_order_relaxed);
+    droppedTickCount.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Getter for the histogram of a phase.
+ *
+ * @param phase the phase
+ * @return the histogram of the durations of the phase
+ */
+const LatencyHistogram &GameStats::getHistogram(Phase phase) const {
+    return histograms[(size_t)phase];
+}
+
+/**
+ * @brief Getter for the number of times a game loop woke more than a tick late.
+ *
+ * @return the number of missed deadlines
+ */
+long GameStats::getMissedDeadlineCount() const {
+    return missedDeadlineCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Getter for the number of ticks dropped because too many were owed.
+ *
+ * @return the number of dropped ticks
+ */
+long GameStats::getDroppedTickCount() const {
+    return droppedTickCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Summarises the timings on a single line, short enough to be drawn over a game board.
+ *
+ * Gives the 99th percentile of each phase, and the number of missed deadlines. The summary is formatted into a buffer
+ * reserved on construction, so drawing it every frame does not allocate.
+ *
+ * @return the summary, valid until the next call
+ */
+const std::string &GameStats::getOverlay() {
+    char formatted[DURATION_SIZE];
+    overlay.assign("p99");
+    for (size_t phase = 0; phase < PHASE_COUNT; phase++) {
+        formatDuration(histograms[phase].getPercentile(99), formatted);
+        overlay.append(" ").append(PHASE_NAMES[phase]).append(" ").append(formatted);
+    }
+    std::snprintf(formatted, sizeof(formatted), "%ld", getMissedDeadlineCount());
+    overlay.append(" missed ").append(formatted);
+    return overlay;
+}
+
+/**
+ * @brief Prints a table of the count, mean, median, 99th percentile and maximum of each phase, followed by the number
+ * of missed deadlines and dropped ticks.
+ *
+ * @param stream the stream to print to
+ */
+void GameStats::print(std::ostream &stream) const {
+    stream << std::left << std::setw(10) << "phase" << std::right << std::setw(10) << "count" << std::setw(10)
+           << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+    for (size_t phase = 0; phase < PHASE_COUNT; phase++) {
+        const LatencyHistogram &histogram = histograms[phase];
+        stream << std::left << std::setw(10) << PHASE_NAMES[phase] << std::right << std::setw(10)
+               << histogram.getCount() << std::setw(10) << formatDuration(histogram.getMean()) << std::setw(10)
+               << formatDuration(histogram.getPercentile(50)) << std::setw(10)
+               << formatDuration(histogram.getPercentile(99)) << std::setw(10) << formatDuration(histogram.getMax())
+               << std::endl;
+    }
+    stream << "Missed deadlines: " << getMissedDeadlineCount() << ", dropped ticks: " << getDroppedTickCount()
+           << std::endl;
+}
+
+/**
+ * @brief Static helper function gets the name of a phase.
+ *
+ * @param phase the phase
+ * @return the name of the phase
+ */
+const char *GameStats::getPhaseName(Phase phase) {
+    return PHASE_NAMES[(size_t)phase];
+}
+
+/**
+ * @brief Static helper function formats a duration in the largest unit it is at least one of.
+ *
+ * @param nanoseconds the duration
+ * @return the duration, such as "850ns", "12.5us" or "1.2ms"
+ */
+std::string GameStats::formatDuration(std::uint64_t nanoseconds) {
+    char formatted[DURATION_SIZE];
+    formatDuration(nanoseconds, formatted);
+    return formatted;
+}
+
+/**
+ * @brief Static helper function formats a duration in the largest unit it is at least one of, without allocating.
+ *
+ * @param nanoseconds the duration
+ * @param buffer the buffer of `DURATION_SIZE` characters the duration is formatted into
+ */
+void GameStats::formatDuration(std::uint64_t nanoseconds, char *buffer) {
+    if (nanoseconds < 1000) {
+        std::snprintf(buffer, DURATION_SIZE, "%" PRIu64 "ns", nanoseconds);
+    } else if (nanoseconds < 1000000) {
+        std::snprintf(buffer, DURATION_SIZE, "%.1fus", (double)nanoseconds / 1e3);
+    } else if (nanoseconds < 1000000000) {
+        std::snprintf(buffer, DURATION_SIZE, "%.1fms", (double)nanoseconds / 1e6);
+    } else {
+        std::snprintf(buffer, DURATION_SIZE, "%.1fs", (double)nanoseconds / 1e9);
+    }
+}
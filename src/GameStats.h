@@ -0,0 +1,141 @@
+/**
+ * File contains declarations for the `LatencyHistogram` and `GameStats` classes.
+ *
+ * @file GameStats.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef GAME_STATS_H
+#define GAME_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#define SUB_BUCKET_BITS 3  // bits of each duration kept below its highest set bit, bounding the error to 12.5%.
+#define SUB_BUCKET_COUNT (1 << SUB_BUCKET_BITS)
+#define HISTOGRAM_BUCKET_COUNT ((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT)
+#define OVERLAY_CAPACITY 160  // characters reserved for the overlay, which is never longer.
+#define DURATION_SIZE 24  // size of the buffer a duration is formatted into, including the terminating null.
+
+/**
+ * @brief The phases of the game loop which are timed.
+ *
+ * `LATENESS` is not a phase of work, but the time the game loop woke after the deadline it slept until.
+ */
+enum class Phase : std::uint8_t {
+    INPUT,
+    UPDATE,
+    COMPOSE,
+    RENDER,
+    LATENESS
+};
+
+#define PHASE_COUNT 5
+
+/**
+ * @brief Declaration for `LatencyHistogram` class.
+ *
+ * Class provides a fixed size, lock-free histogram of durations in nanoseconds. Each power of two is split into
+ * `SUB_BUCKET_COUNT` buckets, so any duration up to centuries is counted in a bucket no more than 12.5% wide, without
+ * allocating. Any number of threads may record into the same histogram, and any thread may read it at the same time:
+ * every count is a relaxed atomic, so a reading may miss durations recorded while it is taken, but never tears.
+ */
+class LatencyHistogram {
+private:
+    std::atomic<std::uint64_t> buckets[HISTOGRAM_BUCKET_COUNT];
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> maximum;
+
+    static size_t bucketOf(std::uint64_t nanoseconds);
+
+    static std::uint64_t bucketLimit(size_t bucket);
+
+public:
+    LatencyHistogram();
+
+    void record(std::uint64_t nanoseconds);
+
+    void reset();
+
+    std::uint64_t getCount() const;
+
+    std::uint64_t getMean() const;
+
+    std::uint64_t getMax() const;
+
+    std::uint64_t getPercentile(double percentile) const;
+};
+
+/**
+ * @brief Declaration for `GameStats` class.
+ *
+ * Class provides the timings of a game loop: a `LatencyHistogram` for each `Phase`, and the number of deadlines missed
+ * and ticks dropped by its `FrameScheduler`. A game given an instance times its phases into it, and games run on
+ * different threads may share an instance. Only the overlay, which is formatted into a buffer reused by every call,
+ * must not be requested by more than one thread at once.
+ */
+class GameStats {
+public:
+    using timer = std::chrono::steady_clock;
+
+    /**
+     * @brief Times a phase from its construction to its destruction, if it is given an instance of `GameStats`.
+     *
+     * Without an instance, the clock is not read, so untimed games pay only for a null check.
+     */
+    class ScopedTimer {
+    private:
+        GameStats *stats;
+        Phase phase;
+        timer::time_point start;
+
+    public:
+        ScopedTimer(GameStats *stats, Phase phase);
+
+        ~ScopedTimer();
+
+        void cancel();
+
+        ScopedTimer(const ScopedTimer &) = delete;
+
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+    };
+
+private:
+    LatencyHistogram histograms[PHASE_COUNT];
+    std::atomic<long> missedDeadlineCount;
+    std::atomic<long> droppedTickCount;
+    std::string overlay;
+
+    static void formatDuration(std::uint64_t nanoseconds, char *buffer);
+
+public:
+    GameStats();
+
+    void record(Phase phase, timer::duration duration);
+
+    void addMissedDeadlines(long missed, long dropped);
+
+    void reset();
+
+    const LatencyHistogram &getHistogram(Phase phase) const;
+
+    long getMissedDeadlineCount() const;
+
+    long getDroppedTickCount() const;
+
+    const std::string &getOverlay();
+
+    void print(std::ostream &stream) const;
+
+    static const char *getPhaseName(Phase phase);
+
+    static std::string formatDuration(std::uint64_t nanoseconds);
+};
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * File contains definition of singleton `GlyphTable` class.
+ *
+ * @file GlyphTable.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <stdexcept>
+#include "GlyphTable.h"
+
+/**
+ * @brief Constructor initialises new instance of `GlyphTable`.
+ *
+ * This constructor is private due to the singleton nature of the class. Each ASCII character is interned with an id
+ * equal to its value.
+ */
+GlyphTable::GlyphTable() {
+    for (int i = 0; i < ASCII_GLYPHS; i++) {
+        glyphs[i] = std::string(1, (char)i);
+        ids[glyphs[i]] = (GlyphId)i;
+    }
+    glyphCount = ASCII_GLYPHS;
+}
+
+/**
+ * @brief Returns current instance of singleton `GlyphTable`.
+ *
+ * The instance is initialised on first use. Initialisation is thread-safe.
+ *
+ * @return the current (and only) instance of `GlyphTable`
+ */
+GlyphTable &GlyphTable::getInstance() {
+    static GlyphTable instance;
+    return instance;
+}
+
+/**
+ * @brief Gets the id of the provided character, interning it if it has not been seen before.
+ *
+ * The character is only copied into a string when it is first interned, so looking up a character already seen does
+ * not allocate.
+ *
+ * @param glyph the UTF-8 encoded character
+ * @return the id of the character
+ * @throws runtime_error if the table is full
+ */
+GlyphId GlyphTable::intern(std::string_view glyph) {
+    if (glyph.length() == 1 && (unsigned char)glyph[0] < ASCII_GLYPHS) {
+        return (GlyphId)glyph[0];
+    }
+    std::lock_guard<std::mutex> lock(internMutex);
+    auto existing = ids.find(glyph);
+    if (existing != ids.end()) {
+        return existing->second;
+    }
+    int id = glyphCount.load(std::memory_order_relaxed);
+    if (id >= MAX_GLYPHS) {
+        throw std::runtime_error("glyph table is full");
+    }
+    glyphs[id] = std::string(glyph);
+    ids[glyphs[id]] = (GlyphId)id;
+    glyphCount.store(id + 1, std::memory_order_release);
+    return (GlyphId)id;
+}
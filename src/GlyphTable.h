@@ -0,0 +1,65 @@
+/**
+ * File contains declaration for singleton `GlyphTable` class.
+ *
+ * @file GlyphTable.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef GLYPH_TABLE_H
+#define GLYPH_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#define MAX_GLYPHS 1024  // capacity of the glyph table, including the pre-interned ASCII characters.
+#define ASCII_GLYPHS 128  // number of pre-interned glyphs, whose ids equal their ASCII values.
+
+using GlyphId = std::uint16_t;
+
+/**
+ * @brief Declaration for singleton `GlyphTable` class.
+ *
+ * Class provides a global table of the UTF-8 encoded characters displayed on the game board. Each character is interned
+ * once and is thereafter referred to by a small integer id, so that entities, game boards and renderers never need to
+ * copy or compare strings. The ASCII characters are interned on construction with ids equal to their values.
+ *
+ * Interned characters are never removed, so an id and the string it refers to remain valid for the lifetime of the
+ * program. Lookups do not lock and may be made concurrently with interning.
+ */
+class GlyphTable {
+private:
+    std::array<std::string, MAX_GLYPHS> glyphs;
+    std::atomic<int> glyphCount;
+    std::unordered_map<std::string_view, GlyphId> ids;  // keys view the strings in `glyphs`, which never move.
+    std::mutex internMutex;
+
+    GlyphTable();
+
+public:
+    static GlyphTable &getInstance();
+
+    GlyphId intern(std::string_view glyph);
+
+    const std::string &lookup(GlyphId id) const {
+        return glyphs[id];
+    }
+
+    /**
+     * @brief Getter for the number of glyphs interned, including the ASCII characters.
+     *
+     * Every glyph id is less than the number of glyphs interned.
+     *
+     * @return the number of glyphs interned
+     */
+    int size() const {
+        return glyphCount.load(std::memory_order_acquire);
+    }
+};
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * File contains declaration for `InputEvent` structure along with the `Key` enumeration class and modifier flags.
+ *
+ * @file InputEvent.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef INPUT_EVENT_H
+#define INPUT_EVENT_H
+
+#include <chrono>
+#include <cstdint>
+
+#define MODIFIER_NONE 0
+#define MODIFIER_SHIFT 1
+#define MODIFIER_ALT 2
+#define MODIFIER_CTRL 4
+
+/**
+ * @brief Declaration of `Key` enumeration.
+ *
+ * Printable characters and control characters without a dedicated key are reported as `CHARACTER`.
+ */
+enum class Key : std::uint8_t {
+    CHARACTER,
+    ESCAPE,
+    ENTER,
+    TAB,
+    BACKSPACE,
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT,
+    HOME,
+    END,
+    INSERT,
+    DELETE,
+    PAGE_UP,
+    PAGE_DOWN,
+    F1,
+    F2,
+    F3,
+    F4,
+    F5,
+    F6,
+    F7,
+    F8,
+    F9,
+    F10,
+    F11,
+    F12,
+    UNKNOWN
+};
+
+/**
+ * @brief Declaration of `InputEvent` structure.
+ *
+ * A single decoded key press: the key, the character it produced (or '\0' if it produced none), a bitmask of the
+ * `MODIFIER_` flags held, and the time the bytes of the key press were read on the monotonic clock.
+ */
+struct InputEvent {
+    Key key;
+    char character;
+    std::uint8_t modifiers;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+#endif
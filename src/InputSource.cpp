@@ -0,0 +1,16 @@
+/**
+ * File contains definition of abstract `InputSource` class.
+ *
+ * @file InputSource.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include "InputSource.h"
+
+/**
+ * @brief Default destructor.
+ *
+ * No memory is allocated.
+ */
+InputSource::~InputSource() = default;
@@ -0,0 +1,35 @@
+/**
+ * File contains declaration for abstract `InputSource` class.
+ *
+ * @file InputSource.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef INPUT_SOURCE_H
+#define INPUT_SOURCE_H
+
+#include <chrono>
+#include <vector>
+#include "InputEvent.h"
+
+/**
+ * @brief Declaration for abstract `InputSource` class.
+ *
+ * Class provides declarations of the operations a game uses to receive input, so that games can be driven either by
+ * the user's keystrokes or by injected input, for example when simulating games without a terminal.
+ */
+class InputSource {
+public:
+    virtual ~InputSource() = 0;
+
+    virtual bool waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) = 0;
+
+    virtual char waitForKey() = 0;
+
+    virtual void waitUntil(std::chrono::steady_clock::time_point deadline) = 0;
+
+    virtual size_t drain(std::vector<InputEvent> &events) = 0;
+};
+
+#endif
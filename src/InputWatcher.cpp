@@ -6,28 +6,60 @@
  * @date 23/11/21
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
 #include <cstdlib>
 #include <unistd.h>
 #include <termios.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include "InputWatcher.h"
+#include "FrameScheduler.h"
+#include "TraceWriter.h"
 
 InputWatcher *InputWatcher::instance = nullptr;  // initialises instance variable to null.
 
+/**
+ * @brief Static helper function traces the arrival of a key press as an instant at the time it was read.
+ *
+ * Character keys are traced with their character code, and other keys with their `Key` value.
+ *
+ * @param event the key press
+ */
+static void traceKeyPress(const InputEvent &event) {
+    if (event.key == Key::CHARACTER) {
+        TraceWriter::instant("InputWatcher::key", "input", "character", event.character, event.timestamp);
+    } else {
+        TraceWriter::instant("InputWatcher::key", "input", "key", (std::int64_t)event.key, event.timestamp);
+    }
+}
+
 /**
  * @brief Constructor initialises new instance of `InputWriter`.
  *
- * This constructor is private due to the singleton nature of the class. The terminal mode is first set to "raw". A
- * detached background thread is then initialised which reads characters from standard input and queues them.
+ * This constructor is private due to the singleton nature of the class. The terminal mode is first set to "raw". An
+ * epoll instance is then created, watching standard input and a timer used to wake at game loop deadlines.
  */
 InputWatcher::InputWatcher() {
     setTerminalModeRaw();
-    ioThread.emplace_back([this] {
-        char c;
-        while (read(STDIN_FILENO, &c, 1) == 1) {
-            this->keyPresses.push(c);
-        }
-    });
-    ioThread[0].detach();
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    struct epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = timerFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event);
+    addSource(STDIN_FILENO);
+}
+
+/**
+ * @brief Destructor closes the epoll instance and timer.
+ *
+ * Additional input sources are owned by the caller which added them and are not closed.
+ */
+InputWatcher::~InputWatcher() {
+    close(timerFd);
+    close(epollFd);
 }
 
 struct termios origTermios;  // struct to store original settings of user terminal.
@@ -79,18 +111,232 @@ InputWatcher &InputWatcher::getInstance() {
 }
 
 /**
- * @brief Gets the character at the front of the queue.
+ * @brief Destroys the current instance of singleton `InputWriter`, if one exists.
+ *
+ * As input is only read when requested by the consumer, no thread needs to be stopped. The terminal mode is reset on
+ * program termination.
+ */
+void InputWatcher::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+/**
+ * @brief Adds a file descriptor to be watched for input, such as a local socket or a gamepad device.
+ *
+ * Bytes read from the source are decoded and queued as key presses alongside those read from standard input. The
+ * source is removed once it reaches end of file or fails to be read.
+ *
+ * @param fd the file descriptor to be watched
+ * @return true if the source was added, false if too many sources are watched or it could not be added
+ */
+bool InputWatcher::addSource(int fd) {
+    if (sources.size() >= MAX_INPUT_SOURCES) {
+        return false;
+    }
+    struct epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+    sources.push_back({fd, KeyDecoder()});
+    return true;
+}
+
+/**
+ * @brief Waits for input or the deadline timer, queueing any input read.
+ *
+ * @param timeout the maximum time to wait in milliseconds, 0 to return immediately or -1 to wait indefinitely
+ * @return true if the deadline timer expired or an input event was queued
+ */
+bool InputWatcher::pump(int timeout) {
+    struct epoll_event events[MAX_INPUT_SOURCES + 1];
+    int count = epoll_wait(epollFd, events, MAX_INPUT_SOURCES + 1, timeout);
+    bool woken = false;
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.fd == timerFd) {
+            std::uint64_t expirations;
+            read(timerFd, &expirations, sizeof(expirations));
+            woken = true;
+        } else {
+            for (WatchedSource &source: sources) {
+                if (source.fd == events[i].data.fd) {
+                    woken = readSource(source) || woken;
+                    break;
+                }
+            }
+        }
+    }
+    return woken;
+}
+
+/**
+ * @brief Reads all of the bytes available from a readable input source and queues the key presses they encode.
+ *
+ * The bytes are decoded by the source's decoder, with every key press completed timestamped with the time of the read,
+ * and traced as an instant at that time.
+ * Key presses decoded while the queue is full are discarded. The source is removed if it has reached end of file or
+ * cannot be read.
+ *
+ * @param source the readable input source
+ * @return true if at least one input event was queued
+ */
+bool InputWatcher::readSource(WatchedSource &source) {
+    char buffer[READ_BUFFER_SIZE];
+    ssize_t count = read(source.fd, buffer, READ_BUFFER_SIZE);
+    if (count < 0 && errno == EINTR) {
+        return false;
+    }
+    if (count <= 0) {
+        int fd = source.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        sources.erase(std::remove_if(sources.begin(), sources.end(),
+                                     [fd](const WatchedSource &watched) { return watched.fd == fd; }),
+                      sources.end());
+        return false;
+    }
+    auto timestamp = std::chrono::steady_clock::now();
+    InputEvent event{};
+    bool queued = false;
+    for (ssize_t i = 0; i < count; i++) {
+        if (source.decoder.decode(buffer[i], timestamp, event)) {
+            queued = keyPresses.push(event) || queued;
+            traceKeyPress(event);
+        }
+    }
+    if (source.decoder.flush(event)) {
+        queued = keyPresses.push(event) || queued;
+        traceKeyPress(event);
+    }
+    return queued;
+}
+
+/**
+ * @brief Gets the input event at the front of the queue.
+ *
+ * Any input already available is read without waiting. The front of the queue is then read and popped.
+ *
+ * @param event set to the input event at the front of the queue, if the queue is not empty
+ * @return true if an input event was popped, false if the queue is empty
+ */
+bool InputWatcher::getEvent(InputEvent &event) {
+    if (keyPresses.empty()) {
+        pump(0);
+    }
+    return keyPresses.pop(event);
+}
+
+/**
+ * @brief Blocks until an input event is available or the timeout expires.
  *
- * Characters read from standard input are queued, with the front of the queue being read and popped here. If the queue
- * is empty, the null character ('\0') is returned.
+ * The calling thread sleeps in the reactor and uses no CPU while waiting.
+ *
+ * @param event set to the input event at the front of the queue, if one became available
+ * @param timeout the maximum time to wait, or a negative duration to wait indefinitely
+ * @return true if an input event was popped, false if the timeout expired first
+ */
+bool InputWatcher::waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!getEvent(event)) {
+        int remaining = -1;
+        if (timeout.count() >= 0) {
+            auto now = std::chrono::steady_clock::now();
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+            if (left.count() <= 0) {
+                return false;
+            }
+            remaining = (int)left.count();
+        }
+        pump(remaining);
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the character of the key press at the front of the queue.
+ *
+ * Key presses which produce no character, such as the arrow keys, are skipped. If the queue is empty, the null
+ * character ('\0') is returned.
  *
  * @return the character at the front of the queue, '\0' if the queue is empty
  */
 char InputWatcher::getKeyPress() {
-    if (keyPresses.empty()) {
-        return '\0';
+    InputEvent front{};
+    while (getEvent(front)) {
+        if (front.character != '\0') {
+            return front.character;
+        }
     }
-    char front = keyPresses.front();
-    keyPresses.pop();
-    return front;
+    return '\0';
+}
+
+/**
+ * @brief Blocks until a key press is available, returning the character at the front of the queue.
+ *
+ * The calling thread sleeps in the reactor and uses no CPU while waiting.
+ *
+ * @return the character at the front of the queue
+ */
+char InputWatcher::waitForKey() {
+    return waitForKey(std::chrono::milliseconds(-1));
+}
+
+/**
+ * @brief Blocks until a key press producing a character is available or the timeout expires.
+ *
+ * Key presses which produce no character, such as the arrow keys, are skipped.
+ *
+ * @param timeout the maximum time to wait, or a negative duration to wait indefinitely
+ * @return the character at the front of the queue, '\0' if the timeout expired first
+ */
+char InputWatcher::waitForKey(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    InputEvent event{};
+    while (true) {
+        std::chrono::milliseconds remaining = timeout;
+        if (timeout.count() >= 0) {
+            auto now = std::chrono::steady_clock::now();
+            remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+            if (remaining.count() < 0) {
+                return '\0';
+            }
+        }
+        if (!waitForEvent(event, remaining)) {
+            return '\0';
+        }
+        if (event.character != '\0') {
+            return event.character;
+        }
+    }
+}
+
+/**
+ * @brief Sleeps until the given deadline or the arrival of input, whichever happens first.
+ *
+ * The deadline timer is armed with the absolute deadline on the monotonic clock, so the wait is as precise as a sleep.
+ * Returns as soon as an input event is queued, so the caller may be woken before the deadline. Input is not consumed;
+ * it remains queued for the next call to `drain` or `getKeyPress`. Re-arming the timer on the next call discards any
+ * expiration left over from an early return.
+ *
+ * @param deadline the time to wait until
+ */
+void InputWatcher::waitUntil(std::chrono::steady_clock::time_point deadline) {
+    struct itimerspec timerValue{};
+    timerValue.it_value = FrameScheduler::toTimespec(deadline);
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &timerValue, nullptr);
+    while (!pump(-1));
+}
+
+/**
+ * @brief Removes every queued input event at once.
+ *
+ * Any input already available is read without waiting before the queue is drained.
+ *
+ * @param events cleared, then filled with the queued input events in the order they were read
+ * @return the number of input events removed
+ */
+size_t InputWatcher::drain(std::vector<InputEvent> &events) {
+    pump(0);
+    return keyPresses.drain(events);
 }
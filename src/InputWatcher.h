@@ -9,25 +9,51 @@
 #ifndef USER_INPUT_H
 #define USER_INPUT_H
 
+#include <chrono>
 #include <vector>
-#include <queue>
-#include <thread>
+#include "RingBuffer.h"
+#include "InputEvent.h"
+#include "InputSource.h"
+#include "KeyDecoder.h"
+
+#define KEY_BUFFER_SIZE 256  // maximum number of unread input events; must be a power of two.
+#define READ_BUFFER_SIZE 64  // maximum number of bytes read from an input source at once.
+#define MAX_INPUT_SOURCES 8  // maximum number of input sources which can be watched, including standard input.
 
 /**
  * @brief Declaration for singleton `InputWatcher` class.
  *
- * Class provides an implementation of singleton class `InputWatcher` which will record user keystrokes to be used as
- * game input. This class shall use the singleton design pattern as it makes changes to the user's terminal, and it must
- * be ensured that these changes are reverted upon program termination.
+ * Class provides an implementation of singleton class `InputWatcher`, an `InputSource` which will record user
+ * keystrokes to be used as game input. This class shall use the singleton design pattern as it makes changes to the
+ * user's terminal, and it must be ensured that these changes are reverted upon program termination.
+ *
+ * Input is gathered by a reactor, rather than a background thread: standard input, any additional input sources and a
+ * deadline timer are multiplexed through a single epoll instance by the thread consuming the input. Whenever a source
+ * is readable, all of the bytes available are read at once, decoded into key presses by the source's `KeyDecoder` and
+ * queued as timestamped events. This allows the game loop to sleep until either its next deadline or the arrival of
+ * input, whichever happens first.
  */
-class InputWatcher {
+class InputWatcher : public InputSource {
 private:
+    struct WatchedSource {
+        int fd;
+        KeyDecoder decoder;
+    };
+
     static InputWatcher *instance;
-    std::queue<char> keyPresses;
-    std::vector<std::thread> ioThread;
+    RingBuffer<InputEvent, KEY_BUFFER_SIZE> keyPresses;
+    int epollFd;
+    int timerFd;
+    std::vector<WatchedSource> sources;
 
     InputWatcher();
 
+    ~InputWatcher() override;
+
+    bool pump(int timeout);
+
+    bool readSource(WatchedSource &source);
+
     static void setTerminalModeRaw();
 
     static void resetTerminalMode();
@@ -35,7 +61,23 @@ private:
 public:
     static InputWatcher &getInstance();
 
+    static void destroyInstance();
+
+    bool addSource(int fd);
+
+    bool getEvent(InputEvent &event);
+
+    bool waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) override;
+
     char getKeyPress();
+
+    char waitForKey() override;
+
+    char waitForKey(std::chrono::milliseconds timeout);
+
+    void waitUntil(std::chrono::steady_clock::time_point deadline) override;
+
+    size_t drain(std::vector<InputEvent> &events) override;
 };
 
 #endif
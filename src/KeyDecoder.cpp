@@ -0,0 +1,264 @@
+/**
+ * File contains definition of `KeyDecoder` class.
+ *
+ * @file KeyDecoder.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include "KeyDecoder.h"
+
+#define ESC 27
+#define DEL 127
+
+/**
+ * @brief Constructor for a new decoder, awaiting the first byte of a key press.
+ */
+KeyDecoder::KeyDecoder() {
+    reset();
+}
+
+/**
+ * @brief Returns the decoder to its initial state, discarding any partially decoded sequence.
+ */
+void KeyDecoder::reset() {
+    state = State::GROUND;
+    paramCount = 0;
+    for (int &param: params) {
+        param = 0;
+    }
+}
+
+/**
+ * @brief Completes the current key press, filling in the provided event.
+ *
+ * The event is timestamped with the time the first byte of the key press was read. The decoder is reset.
+ *
+ * @param key the key pressed
+ * @param character the character produced, or '\0' if none
+ * @param modifiers the modifier flags held
+ * @param event set to the decoded key press
+ * @return true, for convenience
+ */
+bool KeyDecoder::emit(Key key, char character, std::uint8_t modifiers, InputEvent &event) {
+    event = {key, character, modifiers, sequenceStart};
+    reset();
+    return true;
+}
+
+/**
+ * @brief Decodes the next byte read from the terminal.
+ *
+ * @param byte the byte read
+ * @param timestamp the time the byte was read
+ * @param event set to the decoded key press if this byte completes one
+ * @return true if a key press was completed and written to `event`
+ */
+bool KeyDecoder::decode(char byte, std::chrono::steady_clock::time_point timestamp, InputEvent &event) {
+    switch (state) {
+        case State::GROUND:
+            sequenceStart = timestamp;
+            return decodeGround(byte, event);
+        case State::ESCAPE:
+            if (byte == '[') {
+                state = State::CSI;
+                return false;
+            } else if (byte == 'O') {
+                state = State::SS3;
+                return false;
+            } else if (byte == ESC) {
+                // Escape pressed twice: report the first and await the continuation of the second.
+                emit(Key::ESCAPE, ESC, MODIFIER_NONE, event);
+                state = State::ESCAPE;
+                sequenceStart = timestamp;
+                return true;
+            }
+            // Alt held with another key, which produces no character so that it is not taken for the key alone.
+            decodeGround(byte, event);
+            event.character = '\0';
+            event.modifiers |= MODIFIER_ALT;
+            return true;
+        case State::CSI:
+            return decodeCsi(byte, event);
+        case State::SS3:
+            return decodeSs3(byte, event);
+    }
+    return false;
+}
+
+/**
+ * @brief Reports a pending escape byte at the end of a read as the escape key.
+ *
+ * Partially decoded control sequences are left pending, as the remainder may arrive in the next read.
+ *
+ * @param event set to the escape key press if an escape byte was pending
+ * @return true if a key press was written to `event`
+ */
+bool KeyDecoder::flush(InputEvent &event) {
+    if (state != State::ESCAPE) {
+        return false;
+    }
+    return emit(Key::ESCAPE, ESC, MODIFIER_NONE, event);
+}
+
+/**
+ * @brief Decodes a byte which is not part of a sequence.
+ *
+ * @param byte the byte read
+ * @param event set to the decoded key press, unless the byte begins an escape sequence
+ * @return true if a key press was written to `event`
+ */
+bool KeyDecoder::decodeGround(char byte, InputEvent &event) {
+    switch (byte) {
+        case ESC:
+            state = State::ESCAPE;
+            return false;
+        case '\n':
+        case '\r':
+            return emit(Key::ENTER, '\n', MODIFIER_NONE, event);
+        case '\t':
+            return emit(Key::TAB, '\t', MODIFIER_NONE, event);
+        case DEL:
+        case '\b':
+            return emit(Key::BACKSPACE, byte, MODIFIER_NONE, event);
+        default:
+            if (byte >= 1 && byte <= 26) {
+                return emit(Key::CHARACTER, byte, MODIFIER_CTRL, event);  // the letter is `'a' + byte - 1`.
+            }
+            return emit(Key::CHARACTER, byte, MODIFIER_NONE, event);
+    }
+}
+
+/**
+ * @brief Decodes a byte of a CSI sequence (`ESC [`).
+ *
+ * Numeric parameters separated by semicolons are accumulated until the final byte. The second parameter, if present,
+ * holds the xterm modifier flags plus one.
+ *
+ * @param byte the byte read
+ * @param event set to the decoded key press if this is the final byte
+ * @return true if a key press was written to `event`
+ */
+bool KeyDecoder::decodeCsi(char byte, InputEvent &event) {
+    if (byte >= '0' && byte <= '9') {
+        if (paramCount == 0) {
+            paramCount = 1;
+        }
+        if (paramCount <= MAX_SEQUENCE_PARAMS) {
+            params[paramCount - 1] = params[paramCount - 1] * 10 + (byte - '0');
+        }
+        return false;
+    }
+    if (byte == ';') {
+        paramCount = paramCount == 0 ? 2 : paramCount + 1;
+        return false;
+    }
+    if (byte < 0x40 || byte > 0x7E) {
+        return false;  // intermediate bytes are ignored.
+    }
+    auto modifiers = (std::uint8_t)(paramCount >= 2 && params[1] > 0 ? params[1] - 1 : MODIFIER_NONE);
+    switch (byte) {
+        case 'A':
+            return emit(Key::UP, '\0', modifiers, event);
+        case 'B':
+            return emit(Key::DOWN, '\0', modifiers, event);
+        case 'C':
+            return emit(Key::RIGHT, '\0', modifiers, event);
+        case 'D':
+            return emit(Key::LEFT, '\0', modifiers, event);
+        case 'H':
+            return emit(Key::HOME, '\0', modifiers, event);
+        case 'F':
+            return emit(Key::END, '\0', modifiers, event);
+        case 'P':
+            return emit(Key::F1, '\0', modifiers, event);
+        case 'Q':
+            return emit(Key::F2, '\0', modifiers, event);
+        case 'R':
+            return emit(Key::F3, '\0', modifiers, event);
+        case 'S':
+            return emit(Key::F4, '\0', modifiers, event);
+        case 'Z':
+            return emit(Key::TAB, '\t', MODIFIER_SHIFT, event);
+        case '~':
+            break;
+        default:
+            return emit(Key::UNKNOWN, '\0', modifiers, event);
+    }
+    switch (params[0]) {
+        case 1:
+        case 7:
+            return emit(Key::HOME, '\0', modifiers, event);
+        case 2:
+            return emit(Key::INSERT, '\0', modifiers, event);
+        case 3:
+            return emit(Key::DELETE, '\0', modifiers, event);
+        case 4:
+        case 8:
+            return emit(Key::END, '\0', modifiers, event);
+        case 5:
+            return emit(Key::PAGE_UP, '\0', modifiers, event);
+        case 6:
+            return emit(Key::PAGE_DOWN, '\0', modifiers, event);
+        case 11:
+            return emit(Key::F1, '\0', modifiers, event);
+        case 12:
+            return emit(Key::F2, '\0', modifiers, event);
+        case 13:
+            return emit(Key::F3, '\0', modifiers, event);
+        case 14:
+            return emit(Key::F4, '\0', modifiers, event);
+        case 15:
+            return emit(Key::F5, '\0', modifiers, event);
+        case 17:
+            return emit(Key::F6, '\0', modifiers, event);
+        case 18:
+            return emit(Key::F7, '\0', modifiers, event);
+        case 19:
+            return emit(Key::F8, '\0', modifiers, event);
+        case 20:
+            return emit(Key::F9, '\0', modifiers, event);
+        case 21:
+            return emit(Key::F10, '\0', modifiers, event);
+        case 23:
+            return emit(Key::F11, '\0', modifiers, event);
+        case 24:
+            return emit(Key::F12, '\0', modifiers, event);
+        default:
+            return emit(Key::UNKNOWN, '\0', modifiers, event);
+    }
+}
+
+/**
+ * @brief Decodes the final byte of an SS3 sequence (`ESC O`).
+ *
+ * @param byte the byte read
+ * @param event set to the decoded key press
+ * @return true, as SS3 sequences are a single byte long
+ */
+bool KeyDecoder::decodeSs3(char byte, InputEvent &event) {
+    switch (byte) {
+        case 'A':
+            return emit(Key::UP, '\0', MODIFIER_NONE, event);
+        case 'B':
+            return emit(Key::DOWN, '\0', MODIFIER_NONE, event);
+        case 'C':
+            return emit(Key::RIGHT, '\0', MODIFIER_NONE, event);
+        case 'D':
+            return emit(Key::LEFT, '\0', MODIFIER_NONE, event);
+        case 'H':
+            return emit(Key::HOME, '\0', MODIFIER_NONE, event);
+        case 'F':
+            return emit(Key::END, '\0', MODIFIER_NONE, event);
+        case 'P':
+            return emit(Key::F1, '\0', MODIFIER_NONE, event);
+        case 'Q':
+            return emit(Key::F2, '\0', MODIFIER_NONE, event);
+        case 'R':
+            return emit(Key::F3, '\0', MODIFIER_NONE, event);
+        case 'S':
+            return emit(Key::F4, '\0', MODIFIER_NONE, event);
+        default:
+            return emit(Key::UNKNOWN, '\0', MODIFIER_NONE, event);
+    }
+}
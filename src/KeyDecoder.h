@@ -0,0 +1,64 @@
+/**
+ * File contains declaration for `KeyDecoder` class.
+ *
+ * @file KeyDecoder.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef KEY_DECODER_H
+#define KEY_DECODER_H
+
+#include "InputEvent.h"
+
+#define MAX_SEQUENCE_PARAMS 2  // parameters kept from a control sequence; any further parameters are ignored.
+
+/**
+ * @brief Declaration for `KeyDecoder` class.
+ *
+ * Class provides a streaming decoder turning the raw bytes read from a terminal into `InputEvent`s. It is a state
+ * machine which consumes a byte at a time and never allocates, so escape sequences split across reads are decoded
+ * correctly. The following are recognised:
+ *
+ * - printable characters, enter, tab and backspace
+ * - control characters, reported as the control byte itself with the control modifier
+ * - CSI sequences (`ESC [`) for the arrow, navigation and function keys, including xterm modifier parameters
+ * - SS3 sequences (`ESC O`) for the arrow keys and F1 to F4
+ * - alt combinations, sent as escape followed by a key, reported as that key with the alt modifier and no character
+ *
+ * A lone escape byte cannot be told apart from the start of a sequence until the next byte arrives. As terminals write
+ * each sequence at once, a pending escape byte at the end of a read is reported as the escape key by `flush`.
+ */
+class KeyDecoder {
+private:
+    enum class State {
+        GROUND,
+        ESCAPE,
+        CSI,
+        SS3
+    };
+
+    State state;
+    int params[MAX_SEQUENCE_PARAMS];
+    int paramCount;
+    std::chrono::steady_clock::time_point sequenceStart;
+
+    void reset();
+
+    bool emit(Key key, char character, std::uint8_t modifiers, InputEvent &event);
+
+    bool decodeGround(char byte, InputEvent &event);
+
+    bool decodeCsi(char byte, InputEvent &event);
+
+    bool decodeSs3(char byte, InputEvent &event);
+
+public:
+    KeyDecoder();
+
+    bool decode(char byte, std::chrono::steady_clock::time_point timestamp, InputEvent &event);
+
+    bool flush(InputEvent &event);
+};
+
+#endif
@@ -0,0 +1,245 @@
+/**
+ * File contains definitions of the vectorised kernels which move entities stored in an `EntityRegistry`.
+ *
+ * One vector kernel is compiled, chosen by the instruction sets enabled for the build: AVX2 processes 8 entities per
+ * instruction, while SSE2 and NEON process 4. The scalar kernel is always compiled, and moves the entities left over
+ * at the end of the arrays. Every kernel performs the same operations in the same order, so that each produces the
+ * same result.
+ *
+ * @file PhysicsKernel.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include "PhysicsKernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define KERNEL_NAME "AVX2"
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define KERNEL_NAME "SSE2"
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define KERNEL_NAME "NEON"
+#else
+#define KERNEL_NAME "scalar"
+#endif
+
+/**
+ * @brief Moves entities along their velocities for the time they have remaining in the tick, one at a time.
+ *
+ * Each entity is then given a whole tick for the next update. The top and bottom limits of an entity are the rows at
+ * which its drawn cells first cover the top or bottom row of the board. Entities with a clamped boundary are stopped at
+ * these limits, while entities with a reflecting boundary are bounced back from them, with their y velocity reversed.
+ * Reflecting entities are assumed to move less than the height of the board per tick.
+ *
+ * @param arrays the arrays of entity state
+ * @param boardHeight the height of the board
+ * @param first the index of the first entity to move
+ */
+void integrateEntitiesScalar(const EntityArrays &arrays, int boardHeight, std::size_t first) {
+    for (std::size_t i = first; i < arrays.count; i++) {
+        float time = arrays.remainingTime[i];
+        arrays.x[i] = arrays.x[i] + arrays.xVelocity[i] * time;
+        float y = arrays.y[i] + arrays.yVelocity[i] * time;
+        arrays.remainingTime[i] = 1;
+        float top = (float)(((int)arrays.height[i] - 1) >> 1);
+        float bottom = (float)(boardHeight - 1) - top;
+        if (arrays.boundary[i] == BOUNDARY_CLAMP) {
+            y = std::min(std::max(y, top), bottom);
+        } else if (arrays.boundary[i] == BOUNDARY_REFLECT) {
+            if (y < top) {
+                y = (top + top) - y;
+                arrays.yVelocity[i] = -arrays.yVelocity[i];
+            } else if (y > bottom) {
+                y = (bottom + bottom) - y;
+                arrays.yVelocity[i] = -arrays.yVelocity[i];
+            }
+        }
+        arrays.y[i] = y;
+    }
+}
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Moves entities 8 at a time using AVX2, as described for `integrateEntitiesScalar`.
+ *
+ * @param arrays the arrays of entity state
+ * @param boardHeight the height of the board
+ * @return the number of entities moved
+ */
+static std::size_t integrateEntitiesVector(const EntityArrays &arrays, int boardHeight) {
+    const __m256 one = _mm256_set1_ps(1);
+    const __m256 lastRow = _mm256_set1_ps((float)(boardHeight - 1));
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256i integerOne = _mm256_set1_epi32(1);
+    const __m256i clampBoundary = _mm256_set1_epi32(BOUNDARY_CLAMP);
+    const __m256i reflectBoundary = _mm256_set1_epi32(BOUNDARY_REFLECT);
+    std::size_t i = 0;
+    for (; i + 8 <= arrays.count; i += 8) {
+        __m256 time = _mm256_loadu_ps(arrays.remainingTime + i);
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(arrays.x + i),
+                                 _mm256_mul_ps(_mm256_loadu_ps(arrays.xVelocity + i), time));
+        __m256 yVelocity = _mm256_loadu_ps(arrays.yVelocity + i);
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(arrays.y + i), _mm256_mul_ps(yVelocity, time));
+        __m256i rows = _mm256_srai_epi32(
+                _mm256_sub_epi32(_mm256_cvttps_epi32(_mm256_loadu_ps(arrays.height + i)), integerOne), 1);
+        __m256 top = _mm256_cvtepi32_ps(rows);
+        __m256 bottom = _mm256_sub_ps(lastRow, top);
+        __m256i boundary = _mm256_loadu_si256((const __m256i *)(arrays.boundary + i));
+        __m256 isClamped = _mm256_castsi256_ps(_mm256_cmpeq_epi32(boundary, clampBoundary));
+        __m256 isReflected = _mm256_castsi256_ps(_mm256_cmpeq_epi32(boundary, reflectBoundary));
+        __m256 clamped = _mm256_min_ps(_mm256_max_ps(y, top), bottom);
+        __m256 below = _mm256_cmp_ps(y, top, _CMP_LT_OQ);
+        __m256 above = _mm256_cmp_ps(y, bottom, _CMP_GT_OQ);
+        __m256 reflected = _mm256_blendv_ps(
+                _mm256_blendv_ps(y, _mm256_sub_ps(_mm256_add_ps(bottom, bottom), y), above),
+                _mm256_sub_ps(_mm256_add_ps(top, top), y), below);
+        __m256 flipped = _mm256_and_ps(isReflected, _mm256_or_ps(below, above));
+        yVelocity = _mm256_xor_ps(yVelocity, _mm256_and_ps(flipped, signBit));
+        y = _mm256_blendv_ps(_mm256_blendv_ps(y, reflected, isReflected), clamped, isClamped);
+        _mm256_storeu_ps(arrays.x + i, x);
+        _mm256_storeu_ps(arrays.y + i, y);
+        _mm256_storeu_ps(arrays.yVelocity + i, yVelocity);
+        _mm256_storeu_ps(arrays.remainingTime + i, one);
+    }
+    return i;
+}
+
+#elif defined(__SSE2__)
+
+/**
+ * @brief Static helper function selects between two vectors, lane by lane.
+ *
+ * @param mask the lanes to take from the first vector
+ * @param a the first vector
+ * @param b the second vector
+ * @return the selected lanes
+ */
+static inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * @brief Moves entities 4 at a time using SSE2, as described for `integrateEntitiesScalar`.
+ *
+ * @param arrays the arrays of entity state
+ * @param boardHeight the height of the board
+ * @return the number of entities moved
+ */
+static std::size_t integrateEntitiesVector(const EntityArrays &arrays, int boardHeight) {
+    const __m128 one = _mm_set1_ps(1);
+    const __m128 lastRow = _mm_set1_ps((float)(boardHeight - 1));
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128i integerOne = _mm_set1_epi32(1);
+    const __m128i clampBoundary = _mm_set1_epi32(BOUNDARY_CLAMP);
+    const __m128i reflectBoundary = _mm_set1_epi32(BOUNDARY_REFLECT);
+    std::size_t i = 0;
+    for (; i + 4 <= arrays.count; i += 4) {
+        __m128 time = _mm_loadu_ps(arrays.remainingTime + i);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(arrays.x + i), _mm_mul_ps(_mm_loadu_ps(arrays.xVelocity + i), time));
+        __m128 yVelocity = _mm_loadu_ps(arrays.yVelocity + i);
+        __m128 y = _mm_add_ps(_mm_loadu_ps(arrays.y + i), _mm_mul_ps(yVelocity, time));
+        __m128i rows = _mm_srai_epi32(_mm_sub_epi32(_mm_cvttps_epi32(_mm_loadu_ps(arrays.height + i)), integerOne), 1);
+        __m128 top = _mm_cvtepi32_ps(rows);
+        __m128 bottom = _mm_sub_ps(lastRow, top);
+        __m128i boundary = _mm_loadu_si128((const __m128i *)(arrays.boundary + i));
+        __m128 isClamped = _mm_castsi128_ps(_mm_cmpeq_epi32(boundary, clampBoundary));
+        __m128 isReflected = _mm_castsi128_ps(_mm_cmpeq_epi32(boundary, reflectBoundary));
+        __m128 clamped = _mm_min_ps(_mm_max_ps(y, top), bottom);
+        __m128 below = _mm_cmplt_ps(y, top);
+        __m128 above = _mm_cmpgt_ps(y, bottom);
+        __m128 reflected = select(below, _mm_sub_ps(_mm_add_ps(top, top), y),
+                                  select(above, _mm_sub_ps(_mm_add_ps(bottom, bottom), y), y));
+        __m128 flipped = _mm_and_ps(isReflected, _mm_or_ps(below, above));
+        yVelocity = _mm_xor_ps(yVelocity, _mm_and_ps(flipped, signBit));
+        y = select(isClamped, clamped, select(isReflected, reflected, y));
+        _mm_storeu_ps(arrays.x + i, x);
+        _mm_storeu_ps(arrays.y + i, y);
+        _mm_storeu_ps(arrays.yVelocity + i, yVelocity);
+        _mm_storeu_ps(arrays.remainingTime + i, one);
+    }
+    return i;
+}
+
+#elif defined(__ARM_NEON)
+
+/**
+ * @brief Moves entities 4 at a time using NEON, as described for `integrateEntitiesScalar`.
+ *
+ * @param arrays the arrays of entity state
+ * @param boardHeight the height of the board
+ * @return the number of entities moved
+ */
+static std::size_t integrateEntitiesVector(const EntityArrays &arrays, int boardHeight) {
+    const float32x4_t one = vdupq_n_f32(1);
+    const float32x4_t lastRow = vdupq_n_f32((float)(boardHeight - 1));
+    const int32x4_t integerOne = vdupq_n_s32(1);
+    const int32x4_t clampBoundary = vdupq_n_s32(BOUNDARY_CLAMP);
+    const int32x4_t reflectBoundary = vdupq_n_s32(BOUNDARY_REFLECT);
+    std::size_t i = 0;
+    for (; i + 4 <= arrays.count; i += 4) {
+        float32x4_t time = vld1q_f32(arrays.remainingTime + i);
+        float32x4_t x = vaddq_f32(vld1q_f32(arrays.x + i), vmulq_f32(vld1q_f32(arrays.xVelocity + i), time));
+        float32x4_t yVelocity = vld1q_f32(arrays.yVelocity + i);
+        float32x4_t y = vaddq_f32(vld1q_f32(arrays.y + i), vmulq_f32(yVelocity, time));
+        int32x4_t rows = vshrq_n_s32(vsubq_s32(vcvtq_s32_f32(vld1q_f32(arrays.height + i)), integerOne), 1);
+        float32x4_t top = vcvtq_f32_s32(rows);
+        float32x4_t bottom = vsubq_f32(lastRow, top);
+        int32x4_t boundary = vld1q_s32(arrays.boundary + i);
+        uint32x4_t isClamped = vceqq_s32(boundary, clampBoundary);
+        uint32x4_t isReflected = vceqq_s32(boundary, reflectBoundary);
+        float32x4_t clamped = vminq_f32(vmaxq_f32(y, top), bottom);
+        uint32x4_t below = vcltq_f32(y, top);
+        uint32x4_t above = vcgtq_f32(y, bottom);
+        float32x4_t reflected = vbslq_f32(below, vsubq_f32(vaddq_f32(top, top), y),
+                                          vbslq_f32(above, vsubq_f32(vaddq_f32(bottom, bottom), y), y));
+        uint32x4_t flipped = vandq_u32(isReflected, vorrq_u32(below, above));
+        yVelocity = vbslq_f32(flipped, vnegq_f32(yVelocity), yVelocity);
+        y = vbslq_f32(isClamped, clamped, vbslq_f32(isReflected, reflected, y));
+        vst1q_f32(arrays.x + i, x);
+        vst1q_f32(arrays.y + i, y);
+        vst1q_f32(arrays.yVelocity + i, yVelocity);
+        vst1q_f32(arrays.remainingTime + i, one);
+    }
+    return i;
+}
+
+#else
+
+/**
+ * @brief Moves no entities, as no vector instruction set is enabled for the build.
+ *
+ * @param arrays the arrays of entity state
+ * @param boardHeight the height of the board
+ * @return the number of entities moved
+ */
+static std::size_t integrateEntitiesVector(const EntityArrays &arrays, int boardHeight) {
+    return 0;
+}
+
+#endif
+
+/**
+ * @brief Moves entities along their velocities for the time they have remaining in the tick.
+ *
+ * As many entities as possible are moved by the vector kernel, and any left over are moved by the scalar kernel.
+ *
+ * @param arrays the arrays of entity state
+ * @param boardHeight the height of the board
+ */
+void integrateEntities(const EntityArrays &arrays, int boardHeight) {
+    integrateEntitiesScalar(arrays, boardHeight, integrateEntitiesVector(arrays, boardHeight));
+}
+
+/**
+ * @brief Getter for the name of the instruction set used by the vector kernel.
+ *
+ * @return the name of the instruction set
+ */
+const char *getPhysicsKernelName() {
+    return KERNEL_NAME;
+}
@@ -0,0 +1,42 @@
+/**
+ * File contains declarations of the vectorised kernels which move entities stored in an `EntityRegistry`.
+ *
+ * @file PhysicsKernel.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef PHYSICS_KERNEL_H
+#define PHYSICS_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define BOUNDARY_NONE 0  // entity may leave the top and bottom of the board.
+#define BOUNDARY_CLAMP 1  // entity is stopped at the top and bottom of the board.
+#define BOUNDARY_REFLECT 2  // entity bounces off the top and bottom of the board.
+
+/**
+ * @brief Declaration of `EntityArrays` structure.
+ *
+ * Holds pointers to the arrays of entity state read and written by the physics kernels, each holding one element per
+ * entity.
+ */
+struct EntityArrays {
+    float *x;
+    float *y;
+    float *xVelocity;
+    float *yVelocity;
+    float *remainingTime;
+    const float *height;
+    const std::int32_t *boundary;
+    std::size_t count;
+};
+
+void integrateEntities(const EntityArrays &arrays, int boardHeight);
+
+void integrateEntitiesScalar(const EntityArrays &arrays, int boardHeight, std::size_t first = 0);
+
+const char *getPhysicsKernelName();
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * File contains definition of concrete `RecordingInputSource` class.
+ *
+ * @file RecordingInputSource.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include "RecordingInputSource.h"
+
+/**
+ * @brief Constructor for a recording of the input read from the provided input source.
+ *
+ * @param source the input source input is read from, which is not owned
+ */
+RecordingInputSource::RecordingInputSource(InputSource *source) {
+    this->source = source;
+}
+
+/**
+ * @brief Default destructor.
+ *
+ * The recorded input is released with the recording.
+ */
+RecordingInputSource::~RecordingInputSource() = default;
+
+/**
+ * @brief Appends an input event to the recording.
+ *
+ * @param event the input event
+ * @param kind how the event was read, either `RECORDED_TICK` or `RECORDED_KEY`
+ */
+void RecordingInputSource::record(const InputEvent &event, std::uint8_t kind) {
+    inputs.push_back({tickCount, event.key, event.character, event.modifiers, kind});
+}
+
+/**
+ * @brief Waits for an input event from the input source, recording it if one arrives.
+ *
+ * @param event set to the input event, if one arrives
+ * @param timeout the maximum time to wait
+ * @return true if an input event was read
+ */
+bool RecordingInputSource::waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) {
+    if (!source->waitForEvent(event, timeout)) {
+        return false;
+    }
+    record(event, RECORDED_KEY);
+    return true;
+}
+
+/**
+ * @brief Waits for a key press from the input source and records it.
+ *
+ * @return the character of the key press
+ */
+char RecordingInputSource::waitForKey() {
+    char key = source->waitForKey();
+    record({key == 27 ? Key::ESCAPE : Key::CHARACTER, key, MODIFIER_NONE, std::chrono::steady_clock::now()},
+           RECORDED_KEY);
+    return key;
+}
+
+/**
+ * @brief Waits in the input source until the deadline or the arrival of input.
+ *
+ * @param deadline the time to wait until
+ */
+void RecordingInputSource::waitUntil(std::chrono::steady_clock::time_point deadline) {
+    source->waitUntil(deadline);
+}
+
+/**
+ * @brief Drains the input source for a game tick, recording every event against the tick.
+ *
+ * @param events cleared, then filled with the input events read in order
+ * @return the number of input events read
+ */
+size_t RecordingInputSource::drain(std::vector<InputEvent> &events) {
+    size_t count = source->drain(events);
+    for (const InputEvent &event: events) {
+        record(event, RECORDED_TICK);
+    }
+    tickCount++;
+    return count;
+}
+
+/**
+ * @brief Getter for the input recorded so far.
+ *
+ * @return the recorded input events, in the order they were read
+ */
+const std::vector<RecordedInput> &RecordingInputSource::getInputs() const {
+    return inputs;
+}
@@ -0,0 +1,67 @@
+/**
+ * File contains declaration for concrete `RecordingInputSource` class and the `RecordedInput` structure it records.
+ *
+ * @file RecordingInputSource.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef RECORDING_INPUT_SOURCE_H
+#define RECORDING_INPUT_SOURCE_H
+
+#include <cstdint>
+#include <vector>
+#include "InputSource.h"
+
+#define RECORDED_TICK 0  // the input was drained by a game tick.
+#define RECORDED_KEY 1  // the input was waited for outside of a tick, for example by a menu.
+
+/**
+ * @brief Declaration of `RecordedInput` structure.
+ *
+ * A single recorded input event, without its timestamp, along with the tick it was read in and how it was read. The
+ * tick is the number of times input had been drained by game ticks before the event was read.
+ */
+struct RecordedInput {
+    std::uint32_t tick;
+    Key key;
+    char character;
+    std::uint8_t modifiers;
+    std::uint8_t kind;
+};
+
+/**
+ * @brief Declaration for concrete `RecordingInputSource` class.
+ *
+ * Class provides an implementation of abstract superclass `InputSource` which reads input from another input source
+ * and records every event it returns, so that a game can later be replayed with the same input by a
+ * `ReplayInputSource`.
+ *
+ * Events are recorded against ticks rather than times: a game drains its input exactly once per tick, so the number of
+ * drains identifies the tick each event was applied in, however the ticks were paced.
+ */
+class RecordingInputSource : public InputSource {
+private:
+    InputSource *source;
+    std::vector<RecordedInput> inputs;
+    std::uint32_t tickCount = 0;
+
+    void record(const InputEvent &event, std::uint8_t kind);
+
+public:
+    explicit RecordingInputSource(InputSource *source);
+
+    ~RecordingInputSource() override;
+
+    bool waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) override;
+
+    char waitForKey() override;
+
+    void waitUntil(std::chrono::steady_clock::time_point deadline) override;
+
+    size_t drain(std::vector<InputEvent> &events) override;
+
+    const std::vector<RecordedInput> &getInputs() const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * File contains definition of concrete `ReplayInputSource` class.
+ *
+ * @file ReplayInputSource.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <utility>
+#include "ReplayInputSource.h"
+
+/**
+ * @brief Constructor for a replay of the provided recorded input.
+ *
+ * @param inputs the recorded input events, in the order they were read
+ */
+ReplayInputSource::ReplayInputSource(std::vector<RecordedInput> inputs) {
+    this->inputs = std::move(inputs);
+}
+
+/**
+ * @brief Default destructor.
+ *
+ * The recorded input is released with the replay.
+ */
+ReplayInputSource::~ReplayInputSource() = default;
+
+/**
+ * @brief Static helper function converts a recorded input event back into an input event.
+ *
+ * Timestamps are not recorded, so the event is given the epoch of the monotonic clock.
+ *
+ * @param input the recorded input event
+ * @return the input event
+ */
+InputEvent ReplayInputSource::toEvent(const RecordedInput &input) {
+    return {input.key, input.character, input.modifiers, std::chrono::steady_clock::time_point()};
+}
+
+/**
+ * @brief Gets the next key recorded outside of a tick for the current tick, without waiting.
+ *
+ * @param event set to the recorded input event, if there is one
+ * @param timeout ignored, as no more input can arrive while waiting
+ * @return true if an input event was replayed
+ */
+bool ReplayInputSource::waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) {
+    if (position >= inputs.size() || inputs[position].kind != RECORDED_KEY || inputs[position].tick > tickCount) {
+        return false;
+    }
+    event = toEvent(inputs[position++]);
+    return true;
+}
+
+/**
+ * @brief Gets the next key recorded outside of a tick for the current tick, without waiting.
+ *
+ * @return the character of the key, '\0' if there is none
+ */
+char ReplayInputSource::waitForKey() {
+    InputEvent event{};
+    return waitForEvent(event, std::chrono::milliseconds(0)) ? event.character : '\0';
+}
+
+/**
+ * @brief Returns immediately, as replayed input is not paced by the clock.
+ *
+ * @param deadline ignored
+ */
+void ReplayInputSource::waitUntil(std::chrono::steady_clock::time_point deadline) {}
+
+/**
+ * @brief Gets the input events recorded for the next tick.
+ *
+ * Keys recorded outside of a tick up to and including this tick which were not waited for are skipped.
+ *
+ * @param events cleared, then filled with the recorded input events of the tick in order
+ * @return the number of input events replayed
+ */
+size_t ReplayInputSource::drain(std::vector<InputEvent> &events) {
+    events.clear();
+    while (position < inputs.size() && inputs[position].tick <= tickCount) {
+        if (inputs[position].kind == RECORDED_TICK) {
+            events.push_back(toEvent(inputs[position]));
+        }
+        position++;
+    }
+    tickCount++;
+    return events.size();
+}
+
+/**
+ * @brief Checks whether every recorded input event has been replayed or skipped.
+ *
+ * @return true if no recorded input events remain
+ */
+bool ReplayInputSource::exhausted() const {
+    return position >= inputs.size();
+}
@@ -0,0 +1,50 @@
+/**
+ * File contains declaration for concrete `ReplayInputSource` class.
+ *
+ * @file ReplayInputSource.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef REPLAY_INPUT_SOURCE_H
+#define REPLAY_INPUT_SOURCE_H
+
+#include <vector>
+#include "RecordingInputSource.h"
+
+/**
+ * @brief Declaration for concrete `ReplayInputSource` class.
+ *
+ * Class provides an implementation of abstract superclass `InputSource` which supplies the input recorded by a
+ * `RecordingInputSource`, so that a game is given exactly the input it was given when it was recorded. Each drain
+ * returns the events recorded for the next tick, and each wait for a key returns the next key recorded outside of a
+ * tick. It never blocks.
+ *
+ * Keys recorded outside of a tick which are not waited for by the time of the next tick, such as those pressed at
+ * prompts a headless game does not show, are skipped.
+ */
+class ReplayInputSource : public InputSource {
+private:
+    std::vector<RecordedInput> inputs;
+    size_t position = 0;
+    std::uint32_t tickCount = 0;
+
+    static InputEvent toEvent(const RecordedInput &input);
+
+public:
+    explicit ReplayInputSource(std::vector<RecordedInput> inputs);
+
+    ~ReplayInputSource() override;
+
+    bool waitForEvent(InputEvent &event, std::chrono::milliseconds timeout) override;
+
+    char waitForKey() override;
+
+    void waitUntil(std::chrono::steady_clock::time_point deadline) override;
+
+    size_t drain(std::vector<InputEvent> &events) override;
+
+    bool exhausted() const;
+};
+
+#endif
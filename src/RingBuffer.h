@@ -0,0 +1,99 @@
+/**
+ * File contains declaration and definition of the `RingBuffer` class template.
+ *
+ * @file RingBuffer.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Declaration for `RingBuffer` class template.
+ *
+ * Class provides a fixed capacity, lock-free, single-producer/single-consumer queue. Exactly one thread may push and
+ * exactly one thread may pop or drain at any time. The capacity must be a power of two.
+ *
+ * The head and tail indices increase monotonically and are masked on access, so that a full buffer can be told apart
+ * from an empty one without sacrificing a slot. Each index lives on its own cache line to avoid false sharing between
+ * the producer and consumer.
+ *
+ * @tparam T the type of item queued, which should be cheap to copy
+ * @tparam Capacity the maximum number of items which can be queued
+ */
+template<typename T, size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "ring buffer capacity must be a power of two");
+
+private:
+    std::array<T, Capacity> items;
+    alignas(64) std::atomic<size_t> head{0};  // index of the next item to be popped, owned by the consumer.
+    alignas(64) std::atomic<size_t> tail{0};  // index of the next slot to be pushed, owned by the producer.
+
+public:
+    /**
+     * @brief Queues an item. Must only be called by the producer.
+     *
+     * @param item the item to be queued
+     * @return true if the item was queued, false if the buffer is full
+     */
+    bool push(const T &item) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[currentTail & (Capacity - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the item at the front of the queue. Must only be called by the consumer.
+     *
+     * @param item set to the item removed, if the buffer is not empty
+     * @return true if an item was removed, false if the buffer is empty
+     */
+    bool pop(T &item) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes every queued item at once. Must only be called by the consumer.
+     *
+     * @param out cleared, then filled with the items removed in queue order
+     * @return the number of items removed
+     */
+    size_t drain(std::vector<T> &out) {
+        out.clear();
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        size_t currentTail = tail.load(std::memory_order_acquire);
+        for (size_t i = currentHead; i != currentTail; i++) {
+            out.push_back(items[i & (Capacity - 1)]);
+        }
+        head.store(currentTail, std::memory_order_release);
+        return currentTail - currentHead;
+    }
+
+    /**
+     * @brief Determines whether the buffer is empty.
+     *
+     * @return true if no items are queued
+     */
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
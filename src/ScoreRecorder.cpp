@@ -9,21 +9,28 @@
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include "ScoreRecorder.h"
+#include "TraceWriter.h"
 
 #define PATH "scores/"  // relative path to directory containing stored files.
-#define EXT ".high"  // stored file extension.
+#define EXT ".scores"  // stored file extension.
+#define LEGACY_EXT ".high"  // file extension of the text files stored by earlier versions, migrated when first opened.
+
+static_assert(sizeof(ScoreEntry) == 16, "scores are stored as 16 bytes");
 
 /**
  * @brief Basic constructor to initialise new instance of `ScoreRecorder`.
  *
- * A new file stream is opened using the provided extension along with the defined path and file extension. A new file
- * will be created if the file does not exist.
+ * The path of the file is formed using the provided file name along with the defined path and file extension. The file
+ * is not opened until it is first read or written, so games which never record a score never touch the file.
  *
  * @param filename the name of the high score file for a particular game
  */
 ScoreRecorder::ScoreRecorder(const std::string &filename) {
-    file.open(PATH + filename + EXT, std::ios::in | std::ios::out | std::ios::app);
+    path = PATH + filename + EXT;
+    legacyPath = PATH + filename + LEGACY_EXT;
 }
 
 /**
@@ -36,41 +43,206 @@ ScoreRecorder::~ScoreRecorder() {
 }
 
 /**
- * @brief Allows strings to be written to the open file.
+ * @brief Opens the file stream and reads its header, if it is not already open.
+ *
+ * A new file will be created if the file does not exist.
+ *
+ * @return true if the file is open, false if it could not be opened or is not a high score file of this version
+ */
+bool ScoreRecorder::openFile() {
+    if (file.is_open()) {
+        return true;
+    }
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open() && createFile()) {
+        file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    }
+    if (file.is_open() && !readHeader()) {
+        file.close();
+    }
+    return file.is_open();
+}
+
+/**
+ * @brief Creates the file, migrating the scores from a text file stored by an earlier version if there is one.
+ *
+ * The file is written under a temporary name and then renamed, so that an interrupted migration never leaves a
+ * partial file in place. Lines of the text file which do not start with a score are skipped, and the text file is left
+ * in place.
+ *
+ * @return true if the file was created
+ */
+bool ScoreRecorder::createFile() {
+    ScoreFileHeader created{};
+    created.magic = SCORE_MAGIC;
+    created.version = SCORE_VERSION;
+    std::vector<ScoreEntry> entries;
+    std::ifstream legacyFile(legacyPath);
+    std::string line;
+    while (std::getline(legacyFile, line)) {
+        char *end;
+        long score = std::strtol(line.c_str(), &end, 10);
+        if (end == line.c_str()) {
+            continue;
+        }
+        size_t separator = line.find(" - ");
+        std::string playerName = separator == std::string::npos ? "" : line.substr(separator + 3);
+        entries.push_back(toEntry(playerName, (int)score));
+        insertTop(created, entries.back());
+    }
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&created), sizeof(created));
+        output.write(reinterpret_cast<const char *>(entries.data()),
+                     (std::streamsize)(entries.size() * sizeof(ScoreEntry)));
+        if (!output.good()) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    return !error;
+}
+
+/**
+ * @brief Reads the header of the open file, which may have been updated by another recorder since it was last read.
+ *
+ * @return true if the header was read and is that of a high score file of this version
+ */
+bool ScoreRecorder::readHeader() {
+    file.clear();
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    return file.good() && header.magic == SCORE_MAGIC && header.version == SCORE_VERSION &&
+           header.topCount <= TOP_SCORE_COUNT;
+}
+
+/**
+ * @brief Reads every score recorded in the open file, in the order they were recorded.
+ *
+ * A score left partially written at the end of the file is ignored.
+ *
+ * @param entries cleared, then filled with the scores read
+ * @return true if the scores were read
+ */
+bool ScoreRecorder::readEntries(std::vector<ScoreEntry> &entries) {
+    file.clear();
+    file.seekg(0, std::ios::end);
+    std::streamoff size = (std::streamoff)file.tellg() - (std::streamoff)sizeof(ScoreFileHeader);
+    entries.resize(size > 0 ? size / sizeof(ScoreEntry) : 0);
+    file.seekg(sizeof(ScoreFileHeader));
+    file.read(reinterpret_cast<char *>(entries.data()), (std::streamsize)(entries.size() * sizeof(ScoreEntry)));
+    return file.good();
+}
+
+/**
+ * @brief Static helper function inserts a score into the highest scores of a header, if it is high enough.
+ *
+ * The position is found by binary search, after any equal scores so that earlier scores keep their place, and the
+ * lowest score is dropped if the header is full.
+ *
+ * @param header the header
+ * @param entry the score
+ */
+void ScoreRecorder::insertTop(ScoreFileHeader &header, const ScoreEntry &entry) {
+    ScoreEntry *end = header.top + header.topCount;
+    ScoreEntry *position = std::upper_bound(header.top, end, entry, [](const ScoreEntry &a, const ScoreEntry &b) {
+        return a.score > b.score;
+    });
+    if (position == header.top + TOP_SCORE_COUNT) {
+        return;
+    }
+    if (header.topCount < TOP_SCORE_COUNT) {
+        header.topCount++;
+    } else {
+        end--;
+    }
+    std::copy_backward(position, end, end + 1);
+    *position = entry;
+}
+
+/**
+ * @brief Static helper function converts a player name and score into a stored score.
+ *
+ * @param playerName the name of the player, truncated to `SCORE_NAME_LENGTH` characters
+ * @param score the score
+ * @return the stored score
+ */
+ScoreEntry ScoreRecorder::toEntry(const std::string &playerName, int score) {
+    ScoreEntry entry{};
+    entry.score = score;
+    std::memcpy(entry.name, playerName.data(), std::min(playerName.length(), (size_t)SCORE_NAME_LENGTH));
+    return entry;
+}
+
+/**
+ * @brief Static helper function formats a stored score as "<score> - <player_name>" for display.
+ *
+ * @param entry the stored score
+ * @return the formatted score
+ */
+std::string ScoreRecorder::toLine(const ScoreEntry &entry) {
+    return std::to_string(entry.score) + " - " + std::string(entry.name, strnlen(entry.name, SCORE_NAME_LENGTH));
+}
+
+/**
+ * @brief Appends a score to the open file, and inserts it into the highest scores in its header.
  *
- * Checks to ensure the file is open as expected, and that the write operation is successful.
+ * The score is appended before the header is written, so that an interrupted write never leaves the header holding a
+ * score the file does not. The write is traced as a span, including opening the file.
  *
  * @param playerName the name of the user, input when prompted
  * @param score the player's score
  * @return true if the write operation was successful, false if an error occurred
  */
 bool ScoreRecorder::writeScore(const std::string &playerName, int score) {
-    if (file.is_open()) {
-        file << score << " - " << playerName << std::endl;
-    } else {
+    TraceSpan span("ScoreRecorder::writeScore", "io", "score", score);
+    if (!openFile() || !readHeader()) {
         return false;
     }
+    ScoreEntry entry = toEntry(playerName, score);
+    file.clear();
+    file.seekp(0, std::ios::end);
+    file.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    insertTop(header, entry);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.flush();
     return file.good();
 }
 
 /**
- * @brief Reads lines from the high score file.
+ * @brief Reads the highest scores from the high score file.
  *
- * Only the number of specified files will be read. The scores are sorted into descending order before being returned.
+ * Up to `TOP_SCORE_COUNT` scores are read from the header alone. More scores than that require every score in the file
+ * to be read and sorted. The scores are in descending order, with scores of the same value in the order they were
+ * recorded, formatted as "<score> - <player_name>", and padded with empty strings if there are fewer scores than
+ * requested. The read is traced as a span, including opening the file.
  *
- * @param noOfScores the number of lines to be read
- * @return the vector of lines read
+ * @param noOfScores the number of scores to be read
+ * @return the vector of scores read
  */
 std::vector<std::string> ScoreRecorder::getHighScores(int noOfScores) {
+    TraceSpan span("ScoreRecorder::getHighScores", "io", "scores", noOfScores);
     std::vector<std::string> lines;
-    std::string line;
-    if (file.is_open()) {
-        while (std::getline(file, line)) {
-            lines.push_back(line);
+    if (noOfScores <= TOP_SCORE_COUNT) {
+        if (openFile() && readHeader()) {
+            for (int i = 0; i < std::min(noOfScores, (int)header.topCount); i++) {
+                lines.push_back(toLine(header.top[i]));
+            }
+        }
+    } else {
+        std::vector<ScoreEntry> entries;
+        if (openFile() && readEntries(entries)) {
+            std::stable_sort(entries.begin(), entries.end(), [](const ScoreEntry &a, const ScoreEntry &b) {
+                return a.score > b.score;
+            });
+            for (int i = 0; i < std::min(noOfScores, (int)entries.size()); i++) {
+                lines.push_back(toLine(entries[i]));
+            }
         }
     }
-    std::sort(lines.begin(), lines.end(), std::greater<>());
     lines.resize(noOfScores);
     return lines;
 }
-
@@ -8,21 +8,71 @@
 #ifndef SCORE_RECORDER_H
 #define SCORE_RECORDER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <fstream>
 
+#define SCORE_MAGIC 0x52435348u  // "HSCR" in little-endian byte order, identifying a high score file.
+#define SCORE_VERSION 1  // version of the high score file format, incremented whenever it changes.
+#define SCORE_NAME_LENGTH 12  // maximum length of a stored player name, longer names are truncated.
+#define TOP_SCORE_COUNT 10  // number of highest scores kept in the header of a high score file.
+
+/**
+ * @brief A score as stored in a high score file, 16 bytes in size.
+ *
+ * The name is padded with null characters, and is not null terminated if it is of the maximum length.
+ */
+struct ScoreEntry {
+    std::int32_t score;
+    char name[SCORE_NAME_LENGTH];
+};
+
+/**
+ * @brief The header at the start of a high score file.
+ *
+ * Holds the highest scores recorded, in descending order of score and then in the order they were recorded, so that
+ * they can be read without reading the rest of the file.
+ */
+struct ScoreFileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t topCount;
+    std::uint32_t reserved;
+    ScoreEntry top[TOP_SCORE_COUNT];
+};
+
 /**
  * @brief Declaration for `ScoreRecorder` class.
  *
  * Class provides a means to read and write to a high scores file, which will allow high scores to be stored at the end
  * of a game and to be displayed in a menu.
  *
- * Scores are written to file in format "<score> - <player_name>".
+ * Scores are stored in a binary file: a header holding the highest `TOP_SCORE_COUNT` scores in order, followed by
+ * every score recorded as a fixed size `ScoreEntry`. Reading the highest scores only reads the header, and writing a
+ * score appends it and inserts it into the header if it is high enough, so neither slows as scores accumulate. Scores
+ * recorded by earlier versions in a "<score> - <player_name>" text file are migrated when the file is first opened.
  */
 class ScoreRecorder {
 private:
+    std::string path;
+    std::string legacyPath;
     std::fstream file;
+    ScoreFileHeader header{};
+
+    bool openFile();
+
+    bool createFile();
+
+    bool readHeader();
+
+    bool readEntries(std::vector<ScoreEntry> &entries);
+
+    static void insertTop(ScoreFileHeader &header, const ScoreEntry &entry);
+
+    static ScoreEntry toEntry(const std::string &playerName, int score);
+
+    static std::string toLine(const ScoreEntry &entry);
 
 public:
     ScoreRecorder(const std::string &filename);
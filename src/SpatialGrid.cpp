@@ -0,0 +1,227 @@
+/**
+ * File contains definition of `SpatialGrid` class.
+ *
+ * @file SpatialGrid.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include "SpatialGrid.h"
+
+/**
+ * @brief Default constructor for an empty grid with no cells.
+ */
+SpatialGrid::SpatialGrid() {
+    this->columns = 0;
+    this->rows = 0;
+    this->cellSize = GRID_CELL_SIZE;
+}
+
+/**
+ * @brief Constructor for a grid covering a board of the provided size.
+ *
+ * @param width the width of the board
+ * @param height the height of the board
+ * @param cellSize the width and height of each grid cell, in board cells
+ */
+SpatialGrid::SpatialGrid(int width, int height, int cellSize) {
+    this->cellSize = cellSize;
+    this->columns = std::max(1, (width + cellSize - 1) / cellSize);
+    this->rows = std::max(1, (height + cellSize - 1) / cellSize);
+    cells.resize(columns * rows);
+}
+
+/**
+ * @brief Finds the range of grid cells overlapped by a bounding box.
+ *
+ * Board cell `n` spans from `n - 0.5` to `n + 0.5`, as entities are centred on their coordinates. The range is clamped
+ * to the grid, so that bounding boxes partly or wholly outside of the board, including unbounded ones, are still
+ * found in the grid cells along its edge.
+ *
+ * @param bounds the bounding box
+ * @param minColumn set to the first column overlapped
+ * @param minRow set to the first row overlapped
+ * @param maxColumn set to the last column overlapped
+ * @param maxRow set to the last row overlapped
+ */
+void SpatialGrid::cellRange(const Bounds &bounds, int &minColumn, int &minRow, int &maxColumn, int &maxRow) const {
+    auto toCell = [this](float coordinate, int count) {
+        float cell = std::floor((coordinate + 0.5f) / (float)cellSize);
+        return (int)std::clamp(cell, 0.0f, (float)(count - 1));
+    };
+    minColumn = toCell(bounds.left, columns);
+    maxColumn = toCell(bounds.right, columns);
+    minRow = toCell(bounds.top, rows);
+    maxRow = toCell(bounds.bottom, rows);
+}
+
+/**
+ * @brief Checks whether an entity is in the grid.
+ *
+ * @param entity the entity to check
+ * @return true if the entity is in the grid
+ */
+bool SpatialGrid::contains(const Entity *entity) const {
+    EntityHandle handle = entity->getHandle();
+    return handle >= 0 && handle < (EntityHandle)entries.size() && entries[handle].entity == entity;
+}
+
+/**
+ * @brief Lists an entity in every grid cell its bounding box overlaps.
+ *
+ * @param handle the handle of the entity
+ */
+void SpatialGrid::addToCells(EntityHandle handle) {
+    Entry &entry = entries[handle];
+    cellRange(entry.entity->getBounds(), entry.minColumn, entry.minRow, entry.maxColumn, entry.maxRow);
+    for (int row = entry.minRow; row <= entry.maxRow; row++) {
+        for (int column = entry.minColumn; column <= entry.maxColumn; column++) {
+            cells[row * columns + column].push_back(handle);
+        }
+    }
+}
+
+/**
+ * @brief Removes an entity from every grid cell it is listed in.
+ *
+ * @param handle the handle of the entity
+ */
+void SpatialGrid::removeFromCells(EntityHandle handle) {
+    const Entry &entry = entries[handle];
+    for (int row = entry.minRow; row <= entry.maxRow; row++) {
+        for (int column = entry.minColumn; column <= entry.maxColumn; column++) {
+            std::vector<EntityHandle> &cell = cells[row * columns + column];
+            auto it = std::find(cell.begin(), cell.end(), handle);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Adds an entity to the grid.
+ *
+ * Entities already in the grid are updated instead.
+ *
+ * @param entity the entity to add
+ */
+void SpatialGrid::insert(Entity *entity) {
+    if (contains(entity)) {
+        update(entity);
+        return;
+    }
+    EntityHandle handle = entity->getHandle();
+    if (handle >= (EntityHandle)entries.size()) {
+        entries.resize(handle + 1, {nullptr, 0, 0, 0, 0});
+        queryStamps.resize(handle + 1, 0);
+    }
+    entries[handle].entity = entity;
+    count++;
+    addToCells(handle);
+}
+
+/**
+ * @brief Removes an entity from the grid, if it is in the grid.
+ *
+ * @param entity the entity to remove
+ */
+void SpatialGrid::remove(Entity *entity) {
+    if (!contains(entity)) {
+        return;
+    }
+    removeFromCells(entity->getHandle());
+    entries[entity->getHandle()].entity = nullptr;
+    count--;
+}
+
+/**
+ * @brief Updates the grid cells an entity is listed in after it has moved or been resized.
+ *
+ * The entity is only moved between grid cells if the range of grid cells it overlaps has changed, which is rare for
+ * an entity moving at most a few board cells per tick. Entities not in the grid are ignored.
+ *
+ * @param entity the entity which has moved
+ */
+void SpatialGrid::update(Entity *entity) {
+    if (!contains(entity)) {
+        return;
+    }
+    EntityHandle handle = entity->getHandle();
+    const Entry &entry = entries[handle];
+    int minColumn, minRow, maxColumn, maxRow;
+    cellRange(entity->getBounds(), minColumn, minRow, maxColumn, maxRow);
+    if (minColumn == entry.minColumn && minRow == entry.minRow && maxColumn == entry.maxColumn &&
+        maxRow == entry.maxRow) {
+        return;
+    }
+    removeFromCells(handle);
+    addToCells(handle);
+}
+
+/**
+ * @brief Removes every entity from the grid.
+ */
+void SpatialGrid::clear() {
+    for (std::vector<EntityHandle> &cell: cells) {
+        cell.clear();
+    }
+    entries.clear();
+    queryStamps.clear();
+    count = 0;
+}
+
+/**
+ * @brief Finds the entities which may overlap an area.
+ *
+ * Every entity listed in a grid cell overlapped by the area is a candidate, so candidates must still be tested
+ * precisely. Each candidate is returned once, even if it is listed in several of the grid cells searched.
+ *
+ * @param area the area to search
+ * @param candidates cleared and then filled with the entities found
+ */
+void SpatialGrid::query(const Bounds &area, std::vector<Entity *> &candidates) const {
+    candidates.clear();
+    if (++currentQuery == 0) {
+        // The stamp has wrapped around, so old stamps could match the new query.
+        std::fill(queryStamps.begin(), queryStamps.end(), 0);
+        currentQuery = 1;
+    }
+    int minColumn, minRow, maxColumn, maxRow;
+    cellRange(area, minColumn, minRow, maxColumn, maxRow);
+    for (int row = minRow; row <= maxRow; row++) {
+        for (int column = minColumn; column <= maxColumn; column++) {
+            for (EntityHandle handle: cells[row * columns + column]) {
+                if (queryStamps[handle] != currentQuery) {
+                    queryStamps[handle] = currentQuery;
+                    candidates.push_back(entries[handle].entity);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds the entities which may overlap an area, into a buffer owned by the grid.
+ *
+ * The buffer is reused by every query, so its storage is kept from match to match. The results are only valid until
+ * the next query.
+ *
+ * @param area the area to search
+ * @return the entities found
+ */
+const std::vector<Entity *> &SpatialGrid::query(const Bounds &area) const {
+    query(area, results);
+    return results;
+}
+
+/**
+ * @brief Getter for the number of entities in the grid.
+ *
+ * @return the number of entities in the grid
+ */
+int SpatialGrid::size() const {
+    return count;
+}
@@ -0,0 +1,82 @@
+/**
+ * File contains declaration for `SpatialGrid` class.
+ *
+ * @file SpatialGrid.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+#include "Entity.h"
+
+#define GRID_CELL_SIZE 4  // width and height of each grid cell, in board cells.
+
+/**
+ * @brief Declaration for `SpatialGrid` class.
+ *
+ * Class provides a uniform grid broadphase over the game board, so that entities can find the other entities near
+ * them without scanning every entity in the game. The board is divided into square grid cells, each covering a block
+ * of board cells, and every entity is listed in each grid cell its bounding box overlaps. Entities outside of the
+ * board are listed in the grid cells along its edge.
+ *
+ * The grid is updated incrementally: an entity is only moved between grid cells when the range of grid cells it
+ * overlaps changes. Entities are listed by their registry handles, which index the grid's own records of them, so
+ * clearing and refilling the grid for a new match requests no memory from the heap.
+ */
+class SpatialGrid {
+private:
+    /**
+     * @brief Declaration of `Entry` structure.
+     *
+     * Holds an entity in the grid along with the range of grid cells it is currently listed in.
+     */
+    struct Entry {
+        Entity *entity;
+        int minColumn;
+        int minRow;
+        int maxColumn;
+        int maxRow;
+    };
+
+    int columns;
+    int rows;
+    int cellSize;
+    std::vector<std::vector<EntityHandle>> cells;
+    std::vector<Entry> entries;
+    int count = 0;
+    mutable std::vector<unsigned int> queryStamps;
+    mutable unsigned int currentQuery = 0;
+    mutable std::vector<Entity *> results;
+
+    void cellRange(const Bounds &bounds, int &minColumn, int &minRow, int &maxColumn, int &maxRow) const;
+
+    bool contains(const Entity *entity) const;
+
+    void addToCells(EntityHandle handle);
+
+    void removeFromCells(EntityHandle handle);
+
+public:
+    SpatialGrid();
+
+    SpatialGrid(int width, int height, int cellSize = GRID_CELL_SIZE);
+
+    void insert(Entity *entity);
+
+    void remove(Entity *entity);
+
+    void update(Entity *entity);
+
+    void clear();
+
+    void query(const Bounds &area, std::vector<Entity *> &candidates) const;
+
+    const std::vector<Entity *> &query(const Bounds &area) const;
+
+    int size() const;
+};
+
+#endif
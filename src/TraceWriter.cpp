@@ -0,0 +1,291 @@
+/**
+ * File contains definitions of singleton `TraceWriter` class and the `TraceSpan` class which records to it.
+ *
+ * @file TraceWriter.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <cstdio>
+#include <unistd.h>
+#include "TraceWriter.h"
+
+#define TRACE_LINE_SIZE 256  // maximum length of a formatted event, which is far longer than any event recorded.
+
+TraceWriter *TraceWriter::instance = nullptr;
+std::atomic<bool> TraceWriter::enabled{false};
+thread_local TraceWriter::ThreadBuffer *TraceWriter::currentBuffer = nullptr;
+
+/**
+ * @brief Private constructor for the writer of a trace, with no buffers and no file open.
+ */
+TraceWriter::TraceWriter() {
+    this->stopping = false;
+    this->firstEvent = true;
+    this->droppedCount = 0;
+    this->writtenCount = 0;
+    this->processId = (int)getpid();
+}
+
+/**
+ * @brief Starts writing a trace to the provided file, replacing it if it exists.
+ *
+ * Events are recorded from every thread from now on, with times relative to now.
+ *
+ * @param path the path of the trace file
+ * @return true if the trace was started, false if the file could not be opened or a trace has already been written
+ */
+bool TraceWriter::start(const std::string &path) {
+    if (instance != nullptr) {
+        return false;
+    }
+    auto *writer = new TraceWriter();
+    writer->file.open(path, std::ios::trunc);
+    if (!writer->file.is_open()) {
+        delete writer;
+        return false;
+    }
+    writer->file << "{\"traceEvents\":[\n";
+    writer->origin = std::chrono::steady_clock::now();
+    writer->flushThread = std::thread(&TraceWriter::flushLoop, writer);
+    instance = writer;
+    enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Stops the trace, writing every event still buffered and the names of the threads, and closes the file.
+ *
+ * The writer is kept, as other threads may still hold their buffers, so no further trace can be started.
+ *
+ * @return true if the whole trace was written, false if no trace was being written or the file could not be written
+ */
+bool TraceWriter::stop() {
+    if (instance == nullptr || !enabled.exchange(false)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(instance->flushMutex);
+        instance->stopping = true;
+    }
+    instance->flushCondition.notify_all();
+    instance->flushThread.join();
+    std::vector<TraceEvent> events;
+    instance->flush(events);
+
+    std::lock_guard<std::mutex> lock(instance->buffersMutex);
+    char line[TRACE_LINE_SIZE];
+    for (const std::unique_ptr<ThreadBuffer> &buffer: instance->buffers) {
+        if (buffer->threadName != nullptr) {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                          instance->firstEvent ? "" : ",\n", instance->processId, buffer->threadId, buffer->threadName);
+            instance->file << line;
+            instance->firstEvent = false;
+        }
+    }
+    instance->file << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":"
+                   << instance->droppedCount.load() << "}}\n";
+    instance->file.close();
+    return !instance->file.fail();
+}
+
+/**
+ * @brief Determines whether a trace is being written, and so whether events should be recorded.
+ *
+ * @return true if a trace is being written
+ */
+bool TraceWriter::isEnabled() {
+    return enabled.load(std::memory_order_acquire);  // pairs with the release in `start`, publishing the instance.
+}
+
+/**
+ * @brief Records an event to the buffer of the current thread, if a trace is being written.
+ *
+ * The event is dropped if the buffer is full.
+ *
+ * @param event the event
+ */
+void TraceWriter::record(const TraceEvent &event) {
+    if (!isEnabled()) {
+        return;
+    }
+    if (!instance->getThreadBuffer()->events.push(event)) {
+        instance->droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Records an instant event at the provided time, if a trace is being written.
+ *
+ * @param name the name of the event
+ * @param category the category of the event
+ * @param argName the name of the argument of the event, or nullptr if it has none
+ * @param argValue the value of the argument of the event
+ * @param time the time of the event
+ */
+void TraceWriter::instant(const char *name, const char *category, const char *argName, std::int64_t argValue,
+                          std::chrono::steady_clock::time_point time) {
+    if (!isEnabled()) {
+        return;
+    }
+    record({name, category, argName, argValue, toTraceTime(time), -1});
+}
+
+/**
+ * @brief Names the current thread in the trace, if a trace is being written.
+ *
+ * @param name the name of the thread, which must be a string literal
+ */
+void TraceWriter::nameThread(const char *name) {
+    if (!isEnabled()) {
+        return;
+    }
+    ThreadBuffer *buffer = instance->getThreadBuffer();
+    std::lock_guard<std::mutex> lock(instance->buffersMutex);
+    buffer->threadName = name;
+}
+
+/**
+ * @brief Converts a steady clock time to a time in the trace.
+ *
+ * @param time the time to be converted
+ * @return the nanoseconds since the trace was started, or 0 if no trace has been started
+ */
+std::int64_t TraceWriter::toTraceTime(std::chrono::steady_clock::time_point time) {
+    if (instance == nullptr) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - instance->origin).count();
+}
+
+/**
+ * @brief Getter for the number of events written to the trace file. Should only be called once the trace is stopped.
+ *
+ * @return the number of events written
+ */
+long TraceWriter::getWrittenCount() {
+    return instance == nullptr ? 0 : instance->writtenCount;
+}
+
+/**
+ * @brief Getter for the number of events dropped because the buffer of the thread recording them was full.
+ *
+ * @return the number of events dropped
+ */
+long TraceWriter::getDroppedCount() {
+    return instance == nullptr ? 0 : instance->droppedCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the buffer of the current thread, creating it the first time the thread records an event.
+ *
+ * @return the buffer of the current thread
+ */
+TraceWriter::ThreadBuffer *TraceWriter::getThreadBuffer() {
+    if (currentBuffer == nullptr) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->threadId = (int)buffers.size();
+        currentBuffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+    return currentBuffer;
+}
+
+/**
+ * @brief Body of the flush thread, which flushes the buffered events every `TRACE_FLUSH_INTERVAL` until stopped.
+ */
+void TraceWriter::flushLoop() {
+    std::vector<TraceEvent> events;
+    events.reserve(TRACE_BUFFER_SIZE);
+    std::unique_lock<std::mutex> lock(flushMutex);
+    while (!stopping) {
+        flushCondition.wait_for(lock, TRACE_FLUSH_INTERVAL, [this] { return stopping; });
+        lock.unlock();
+        flush(events);
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Drains the buffer of every thread and writes the events to the file.
+ *
+ * The buffers are listed under the lock, so that threads can still create their buffers while the events are written.
+ *
+ * @param events reused to hold the events drained from each buffer
+ */
+void TraceWriter::flush(std::vector<TraceEvent> &events) {
+    std::vector<ThreadBuffer *> flushing;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (const std::unique_ptr<ThreadBuffer> &buffer: buffers) {
+            flushing.push_back(buffer.get());
+        }
+    }
+    for (ThreadBuffer *buffer: flushing) {
+        buffer->events.drain(events);
+        for (const TraceEvent &event: events) {
+            writeEvent(event, buffer->threadId);
+        }
+    }
+    file.flush();
+}
+
+/**
+ * @brief Writes an event to the file as a JSON object, with its times in microseconds.
+ *
+ * @param event the event
+ * @param threadId the identifier of the thread which recorded the event
+ */
+void TraceWriter::writeEvent(const TraceEvent &event, int threadId) {
+    char line[TRACE_LINE_SIZE];
+    int length = std::snprintf(line, sizeof(line),
+                               "%s{\"name\":\"%s\",\"cat\":\"%s\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f",
+                               firstEvent ? "" : ",\n", event.name, event.category, processId, threadId,
+                               (double)event.start / 1e3);
+    if (event.duration >= 0) {
+        length += std::snprintf(line + length, sizeof(line) - length, ",\"ph\":\"X\",\"dur\":%.3f",
+                                (double)event.duration / 1e3);
+    } else {
+        length += std::snprintf(line + length, sizeof(line) - length, ",\"ph\":\"i\",\"s\":\"t\"");
+    }
+    if (event.argName != nullptr) {
+        std::snprintf(line + length, sizeof(line) - length, ",\"args\":{\"%s\":%lld}}", event.argName,
+                      (long long)event.argValue);
+    } else {
+        std::snprintf(line + length, sizeof(line) - length, "}");
+    }
+    file << line;
+    firstEvent = false;
+    writtenCount++;
+}
+
+/**
+ * @brief Constructor for `TraceSpan`, starting the span if a trace is being written.
+ *
+ * @param name the name of the span, which must be a string literal
+ * @param category the category of the span, which must be a string literal
+ * @param argName the name of the argument of the span, which must be a string literal, or nullptr if it has none
+ * @param argValue the value of the argument of the span
+ */
+TraceSpan::TraceSpan(const char *name, const char *category, const char *argName /* = nullptr */,
+                     std::int64_t argValue /* = 0 */) {
+    this->active = TraceWriter::isEnabled();
+    if (active) {
+        this->event = {name, category, argName, argValue, 0, 0};
+        this->start = std::chrono::steady_clock::now();
+    }
+}
+
+/**
+ * @brief Destructor for `TraceSpan`, recording the span if it was started.
+ */
+TraceSpan::~TraceSpan() {
+    if (active) {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        event.start = TraceWriter::toTraceTime(start);
+        event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        TraceWriter::record(event);
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * File contains declarations for singleton `TraceWriter` class and the `TraceSpan` class which records to it.
+ *
+ * @file TraceWriter.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RingBuffer.h"
+
+#define TRACE_BUFFER_SIZE 8192  // events each thread may buffer before they are dropped; must be a power of two.
+#define TRACE_FLUSH_INTERVAL std::chrono::milliseconds(50)  // time between flushes of the buffered events.
+
+/**
+ * @brief Declaration of `TraceEvent` structure.
+ *
+ * Holds a single trace event: a span of time if it has a duration, or else an instant. The name, category and argument
+ * name must be string literals, or otherwise live until the trace is stopped, and must not need escaping in JSON.
+ */
+struct TraceEvent {
+    const char *name;
+    const char *category;
+    const char *argName;  // nullptr if the event has no argument.
+    std::int64_t argValue;
+    std::int64_t start;  // nanoseconds since the trace was started.
+    std::int64_t duration;  // nanoseconds, or negative for an instant.
+};
+
+/**
+ * @brief Declaration for singleton `TraceWriter` class.
+ *
+ * Class provides a writer of trace files in the Chrome trace event JSON format, which can be loaded into a trace viewer
+ * such as Perfetto. Each thread which records an event is given its own lock-free buffer the first time it does so,
+ * so recording never contends with other threads or waits for the file. A flush thread drains every buffer every
+ * `TRACE_FLUSH_INTERVAL`, formats the events and writes them to the file. Events recorded while a buffer is full are
+ * dropped and counted, rather than holding up the thread recording them.
+ *
+ * Only one trace can be written by each process. While no trace is being written, recording an event returns straight
+ * away without reading the clock.
+ */
+class TraceWriter {
+private:
+    /**
+     * @brief The buffer of events recorded by a thread, which only that thread pushes to and the flush thread drains.
+     */
+    struct ThreadBuffer {
+        RingBuffer<TraceEvent, TRACE_BUFFER_SIZE> events;
+        int threadId;
+        const char *threadName = nullptr;
+    };
+
+    static TraceWriter *instance;
+    static std::atomic<bool> enabled;
+    static thread_local ThreadBuffer *currentBuffer;  // the buffer of the current thread, once it has recorded.
+    std::chrono::steady_clock::time_point origin;
+    std::ofstream file;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;  // never shrunk, as threads keep pointers to their buffers.
+    std::mutex buffersMutex;
+    std::thread flushThread;
+    std::mutex flushMutex;
+    std::condition_variable flushCondition;
+    bool stopping;
+    bool firstEvent;
+    std::atomic<long> droppedCount;
+    long writtenCount;
+    int processId;
+
+    TraceWriter();
+
+    void flushLoop();
+
+    void flush(std::vector<TraceEvent> &events);
+
+    void writeEvent(const TraceEvent &event, int threadId);
+
+    ThreadBuffer *getThreadBuffer();
+
+public:
+    static bool start(const std::string &path);
+
+    static bool stop();
+
+    static bool isEnabled();
+
+    static void record(const TraceEvent &event);
+
+    static void instant(const char *name, const char *category, const char *argName, std::int64_t argValue,
+                        std::chrono::steady_clock::time_point time);
+
+    static void nameThread(const char *name);
+
+    static std::int64_t toTraceTime(std::chrono::steady_clock::time_point time);
+
+    static long getWrittenCount();
+
+    static long getDroppedCount();
+};
+
+/**
+ * @brief Declaration for `TraceSpan` class.
+ *
+ * Class records a span to the trace from its construction to its destruction, if a trace is being written when it is
+ * constructed. Otherwise, it does nothing.
+ */
+class TraceSpan {
+private:
+    TraceEvent event;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    TraceSpan(const char *name, const char *category, const char *argName = nullptr, std::int64_t argValue = 0);
+
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan &) = delete;
+
+    TraceSpan &operator=(const TraceSpan &) = delete;
+};
+
+#endif
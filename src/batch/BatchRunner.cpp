@@ -0,0 +1,292 @@
+/**
+ * File contains a runner which plays batches of headless AI versus AI games of Pong across every core and reports the
+ * results of each pairing of difficulties, built by the `BatchRunner` make target.
+ *
+ * @file BatchRunner.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../BufferedInputSource.h"
+#include "../renderer/NullRenderer.h"
+#include "../pong/Pong.h"
+#include "WorkStealingPool.h"
+
+#define BOARD_WIDTH 101
+#define BOARD_HEIGHT 31
+#define DIFFICULTY_COUNT 4  // number of AI difficulty levels, from 0 (easy) to 3 (extreme).
+#define DEFAULT_MATCHES 100  // number of matches played for each pairing of difficulties by default.
+#define DEFAULT_SEED 1  // seed of the first match of each pairing by default.
+#define DEFAULT_MAX_SCORE 5
+#define DEFAULT_MAX_TIME 2  // minutes.
+
+static const char *const DIFFICULTY_NAMES[DIFFICULTY_COUNT] = {"Easy", "Moderate", "Hard", "Extreme"};
+
+/**
+ * @brief Declaration of `MatchResult` structure.
+ *
+ * Holds the outcome of a single match: the final scores and the number of ticks it lasted.
+ */
+struct MatchResult {
+    int scores[2];
+    long ticks;
+};
+
+/**
+ * @brief Declaration of `PairingSummary` structure.
+ *
+ * Holds the totals of the matches played between a pair of difficulties.
+ */
+struct PairingSummary {
+    long matches = 0;
+    long wins[2] = {0, 0};
+    long ties = 0;
+    long ticks = 0;
+    long shortest = 0;
+    long longest = 0;
+};
+
+/**
+ * @brief Static helper function plays a headless AI versus AI match to completion.
+ *
+ * Every match has its own renderer, input source and game, so matches can be played concurrently. Matches may share
+ * their timings, which are recorded without locking.
+ *
+ * @param config the settings of the match
+ * @param stats the timings the phases of the match are recorded to, or nullptr if it is not timed
+ * @return the outcome of the match
+ */
+static MatchResult playMatch(const PongConfig &config, GameStats *stats) {
+    NullRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT);
+    BufferedInputSource input;
+    Pong pong(&renderer, config, &input);
+    pong.setStats(stats, false);
+    pong.runGameLoop();
+    return {{pong.getScore(0), pong.getScore(1)}, pong.getTickCount()};
+}
+
+/**
+ * @brief Static helper function totals the outcomes of the matches played between a pair of difficulties.
+ *
+ * @param results the outcomes of the matches
+ * @return the totals of the matches
+ */
+static PairingSummary summarise(const std::vector<MatchResult> &results) {
+    PairingSummary summary;
+    for (const MatchResult &result: results) {
+        if (result.scores[0] == result.scores[1]) {
+            summary.ties++;
+        } else {
+            summary.wins[result.scores[0] > result.scores[1] ? 0 : 1]++;
+        }
+        summary.shortest = summary.matches == 0 ? result.ticks : std::min(summary.shortest, result.ticks);
+        summary.longest = std::max(summary.longest, result.ticks);
+        summary.ticks += result.ticks;
+        summary.matches++;
+    }
+    return summary;
+}
+
+/**
+ * @brief Static helper function formats a proportion as a percentage.
+ *
+ * @param count the count
+ * @param total the total the count is a proportion of
+ * @return the percentage, to one decimal place
+ */
+static std::string percentage(long count, long total) {
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(1) << (total == 0 ? 0.0 : 100.0 * (double)count / (double)total) << "%";
+    return stream.str();
+}
+
+/**
+ * @brief Static helper function prints the results of every pairing, and the overall results of each difficulty.
+ *
+ * Match lengths are given in seconds of play.
+ *
+ * @param summaries the totals of the matches played between each pair of difficulties, indexed by the difficulty of
+ * the left player and then that of the right player
+ * @param tickRate the tick rate the matches were played at, in ticks per second
+ */
+static void printResults(const PairingSummary summaries[DIFFICULTY_COUNT][DIFFICULTY_COUNT], int tickRate) {
+    auto seconds = [tickRate](double ticks) {
+        return ticks / tickRate;
+    };
+    std::cout << std::left << std::setw(10) << "left" << std::setw(10) << "right" << std::right << std::setw(9)
+              << "matches" << std::setw(11) << "left wins" << std::setw(12) << "right wins" << std::setw(9) << "ties"
+              << std::setw(12) << "mean len" << std::setw(10) << "min len" << std::setw(10) << "max len" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (int left = 0; left < DIFFICULTY_COUNT; left++) {
+        for (int right = 0; right < DIFFICULTY_COUNT; right++) {
+            const PairingSummary &summary = summaries[left][right];
+            std::cout << std::left << std::setw(10) << DIFFICULTY_NAMES[left]
+                      << std::setw(10) << DIFFICULTY_NAMES[right] << std::right << std::setw(9) << summary.matches
+                      << std::setw(11) << percentage(summary.wins[0], summary.matches)
+                      << std::setw(12) << percentage(summary.wins[1], summary.matches)
+                      << std::setw(9) << percentage(summary.ties, summary.matches)
+                      << std::setw(11) << seconds((double)summary.ticks / (double)summary.matches) << "s"
+                      << std::setw(9) << seconds((double)summary.shortest) << "s"
+                      << std::setw(9) << seconds((double)summary.longest) << "s" << std::endl;
+        }
+    }
+
+    std::cout << std::endl << std::left << std::setw(10) << "difficulty" << std::right << std::setw(9) << "matches"
+              << std::setw(9) << "wins" << std::setw(9) << "losses" << std::setw(9) << "ties" << std::endl;
+    for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++) {
+        // Matches against the same difficulty are left out, as they are won as often as they are lost.
+        long matches = 0;
+        long wins = 0;
+        long losses = 0;
+        for (int opponent = 0; opponent < DIFFICULTY_COUNT; opponent++) {
+            if (opponent == difficulty) {
+                continue;
+            }
+            const PairingSummary &asLeft = summaries[difficulty][opponent];
+            const PairingSummary &asRight = summaries[opponent][difficulty];
+            matches += asLeft.matches + asRight.matches;
+            wins += asLeft.wins[0] + asRight.wins[1];
+            losses += asLeft.wins[1] + asRight.wins[0];
+        }
+        std::cout << std::left << std::setw(10) << DIFFICULTY_NAMES[difficulty] << std::right << std::setw(9) << matches
+                  << std::setw(9) << percentage(wins, matches) << std::setw(9) << percentage(losses, matches)
+                  << std::setw(9) << percentage(matches - wins - losses, matches) << std::endl;
+    }
+}
+
+/**
+ * @brief Main function plays every pairing of difficulties in AI versus AI matches and prints the results.
+ *
+ * Each pairing plays the same number of matches, with the same seeds: match `i` of every pairing is seeded with the
+ * base seed plus `i`, so pairings are compared over the same serves. Every match is a task of a `WorkStealingPool` with
+ * a worker for each core, and is independent of every other, so the results do not depend on the number of threads.
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments: optionally the number of matches played for each pairing, the number of
+ * threads, the base seed, the score and time limits of each match, how the AI paddles choose where to move, and the
+ * tick rate, ball speed and speed ramp of each match; and whether every match is timed, in which case the timings of
+ * the phases of the game loop across every match are printed after the results
+ * @return the exit status of the program
+ */
+int main(int argc, char *argv[]) {
+    long matchCount = DEFAULT_MATCHES;
+    long threadCount = std::thread::hardware_concurrency();
+    long baseSeed = DEFAULT_SEED;
+    long maxScore = DEFAULT_MAX_SCORE;
+    long maxTime = DEFAULT_MAX_TIME;
+    PaddleAI AIMode = PaddleAI::TRACKING;
+    long tickRate = BASE_TICK_RATE;
+    long ballSpeed = BASE_TICK_RATE;
+    long speedRamp = 0;
+    bool collectStats = false;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            if (argument == "--stats") {
+                collectStats = true;
+            } else if (i + 1 >= argc) {
+                throw std::invalid_argument(argument);
+            } else if (argument == "--matches") {
+                matchCount = std::stol(argv[++i]);
+            } else if (argument == "--threads") {
+                threadCount = std::stol(argv[++i]);
+            } else if (argument == "--seed") {
+                baseSeed = std::stol(argv[++i]);
+            } else if (argument == "--max-score") {
+                maxScore = std::stol(argv[++i]);
+            } else if (argument == "--max-time") {
+                maxTime = std::stol(argv[++i]);
+            } else if (argument == "--tick-rate") {
+                tickRate = std::stol(argv[++i]);
+            } else if (argument == "--ball-speed") {
+                ballSpeed = std::stol(argv[++i]);
+            } else if (argument == "--speed-ramp") {
+                speedRamp = std::stol(argv[++i]);
+            } else if (argument == "--ai" && std::string(argv[i + 1]) == "tracking") {
+                AIMode = PaddleAI::TRACKING;
+                i++;
+            } else if (argument == "--ai" && std::string(argv[i + 1]) == "predictive") {
+                AIMode = PaddleAI::PREDICTIVE;
+                i++;
+            } else {
+                throw std::invalid_argument(argument);
+            }
+        }
+        if (matchCount <= 0 || threadCount < 0 || maxScore < 0 || maxTime < 0 || maxScore + maxTime == 0 ||
+            tickRate < MIN_TICK_RATE || tickRate > MAX_TICK_RATE || ballSpeed < MIN_BALL_SPEED ||
+            ballSpeed > MAX_BALL_SPEED || speedRamp < 0) {
+            throw std::invalid_argument("out of range");
+        }
+    } catch (const std::logic_error &error) {
+        std::cerr << "Usage: " << argv[0] << " [--matches N] [--threads N] [--seed N] [--max-score N] [--max-time N]"
+                  << std::endl << "       [--ai tracking|predictive] [--tick-rate N] [--ball-speed N] [--speed-ramp N]"
+                  << " [--stats]"
+                  << std::endl << "Every match needs a score limit, a time limit in minutes or both." << std::endl;
+        return 1;
+    }
+
+    std::vector<MatchResult> results[DIFFICULTY_COUNT][DIFFICULTY_COUNT];
+    GameStats stats;
+    GameStats *sharedStats = collectStats ? &stats : nullptr;
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(threadCount);
+        for (int left = 0; left < DIFFICULTY_COUNT; left++) {
+            for (int right = 0; right < DIFFICULTY_COUNT; right++) {
+                // Each match writes only its own result, so results are recorded without locking.
+                results[left][right].resize(matchCount);
+                for (long match = 0; match < matchCount; match++) {
+                    PongConfig config;
+                    config.AICount = 2;
+                    config.difficulty[0] = left;
+                    config.difficulty[1] = right;
+                    config.maxScore = (int)maxScore;
+                    config.maxTime = (int)maxTime;
+                    config.headless = true;
+                    config.seed = (std::uint32_t)(baseSeed + match);
+                    config.AIMode = AIMode;
+                    config.tickRate = (int)tickRate;
+                    config.ballSpeed = (int)ballSpeed;
+                    config.speedRamp = (int)speedRamp;
+                    MatchResult *result = &results[left][right][match];
+                    pool.submit([config, result, sharedStats]() {
+                        *result = playMatch(config, sharedStats);
+                    });
+                }
+            }
+        }
+        pool.wait();
+        threadCount = (long)pool.getThreadCount();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    PairingSummary summaries[DIFFICULTY_COUNT][DIFFICULTY_COUNT];
+    long totalTicks = 0;
+    for (int left = 0; left < DIFFICULTY_COUNT; left++) {
+        for (int right = 0; right < DIFFICULTY_COUNT; right++) {
+            summaries[left][right] = summarise(results[left][right]);
+            totalTicks += summaries[left][right].ticks;
+        }
+    }
+    long totalMatches = matchCount * DIFFICULTY_COUNT * DIFFICULTY_COUNT;
+    std::cout << "Played " << totalMatches << " matches (" << totalTicks << " ticks) on " << threadCount
+              << " threads in " << std::fixed << std::setprecision(2) << elapsed << " s, "
+              << std::setprecision(0) << (double)totalTicks / tickRate / elapsed << "x real time."
+              << std::endl << std::endl;
+    printResults(summaries, (int)tickRate);
+    if (collectStats) {
+        std::cout << std::endl;
+        stats.print(std::cout);
+    }
+    return 0;
+}
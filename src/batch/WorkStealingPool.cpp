@@ -0,0 +1,172 @@
+/**
+ * File contains definition of `WorkStealingPool` class.
+ *
+ * @file WorkStealingPool.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include "WorkStealingPool.h"
+
+// The pool and index of the worker running on the current thread, if it is a worker thread.
+static thread_local size_t currentWorker = SIZE_MAX;
+static thread_local const WorkStealingPool *currentPool = nullptr;
+
+/**
+ * @brief Constructor starts the provided number of worker threads, each with an empty queue.
+ *
+ * @param threadCount the number of worker threads, at least one of which is always started
+ */
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+    threadCount = std::max<size_t>(threadCount, 1);
+    for (size_t i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&WorkStealingPool::runWorker, this, i);
+    }
+}
+
+/**
+ * @brief Destructor stops and joins the worker threads.
+ *
+ * Tasks still queued are discarded, so `wait` should be called first if they are to be run.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workCondition.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Submits a task to be run by a worker.
+ *
+ * A task submitted by a task of this pool is added to the queue of the worker running it. Other tasks are dealt to the
+ * queues of the workers in turn.
+ *
+ * @param task the task
+ */
+void WorkStealingPool::submit(Task task) {
+    size_t index = currentWorker;
+    if (currentPool != this) {
+        index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+    {
+        // The counts are raised before the task is queued, so that they never fall below zero when it is taken, and
+        // while holding the state mutex, so that a worker about to sleep cannot miss the task.
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pendingCount++;
+        queuedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    workCondition.notify_one();
+}
+
+/**
+ * @brief Takes a task for a worker, from the back of its own queue or else from the front of another worker's queue.
+ *
+ * The other queues are searched starting from the next worker, so that thieves spread across the queues.
+ *
+ * @param index the index of the worker
+ * @param task set to the task taken, if there is one
+ * @return true if a task was taken
+ */
+bool WorkStealingPool::takeTask(size_t index, Task &task) {
+    {
+        WorkerQueue &own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkerQueue &victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Runs tasks on a worker thread until the pool is stopped, sleeping while no tasks are queued.
+ *
+ * @param index the index of the worker
+ */
+void WorkStealingPool::runWorker(size_t index) {
+    currentWorker = index;
+    currentPool = this;
+    Task task;
+    while (true) {
+        if (takeTask(index, task)) {
+            std::exception_ptr exception;
+            try {
+                task();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            task = nullptr;
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (exception != nullptr && firstException == nullptr) {
+                firstException = exception;
+            }
+            if (--pendingCount == 0) {
+                idleCondition.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workCondition.wait(lock, [this]() {
+            return stopping || queuedCount.load(std::memory_order_relaxed) > 0;
+        });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Waits until every task submitted has been run, including the tasks submitted by those tasks.
+ *
+ * Must not be called by a task of this pool.
+ *
+ * @throws the first exception thrown by a task since the last wait, if any
+ */
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    idleCondition.wait(lock, [this]() {
+        return pendingCount == 0;
+    });
+    if (firstException != nullptr) {
+        std::exception_ptr exception = firstException;
+        firstException = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+/**
+ * @brief Getter for the number of worker threads.
+ *
+ * @return the number of worker threads
+ */
+size_t WorkStealingPool::getThreadCount() const {
+    return workers.size();
+}
@@ -0,0 +1,78 @@
+/**
+ * File contains declaration for `WorkStealingPool` class.
+ *
+ * @file WorkStealingPool.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Declaration for `WorkStealingPool` class.
+ *
+ * Class provides a pool of worker threads which run submitted tasks. Each worker has its own queue: tasks submitted
+ * from outside the pool are dealt to the queues in turn, and tasks submitted by a task are added to the queue of the
+ * worker running it. A worker takes the newest task from its own queue, and once its queue is empty it steals the
+ * oldest task from the queue of another worker, so that workers given tasks which finish quickly take over the tasks of
+ * those given tasks which run for longer. Workers sleep while every queue is empty.
+ *
+ * Tasks which throw do not stop the pool; the first exception thrown is rethrown by `wait`.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    /**
+     * @brief The queue of tasks of a worker, which the worker takes from the back of and other workers steal from the
+     * front of.
+     */
+    struct WorkerQueue {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queuedCount{0};
+    std::atomic<size_t> nextQueue{0};
+    size_t pendingCount = 0;
+    bool stopping = false;
+    std::exception_ptr firstException;
+    std::mutex stateMutex;
+    std::condition_variable workCondition;
+    std::condition_variable idleCondition;
+
+    void runWorker(size_t index);
+
+    bool takeTask(size_t index, Task &task);
+
+public:
+    explicit WorkStealingPool(size_t threadCount);
+
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    void submit(Task task);
+
+    void wait();
+
+    size_t getThreadCount() const;
+};
+
+#endif
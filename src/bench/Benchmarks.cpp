@@ -0,0 +1,547 @@
+/**
+ * File contains the micro-benchmarks for the hot paths of the game, which are run by the `bench` make target.
+ *
+ * @file Benchmarks.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../BufferedInputSource.h"
+#include "../GameStats.h"
+#include "../ScoreRecorder.h"
+#include "../TraceWriter.h"
+#include "../SpatialGrid.h"
+#include "../renderer/ConsoleRenderer.h"
+#include "../renderer/DotMatrixRenderer.h"
+#include "../renderer/NullRenderer.h"
+#include "../renderer/SharedMemoryRenderer.h"
+#include "../renderer/ThreadedRenderer.h"
+#include "../pong/Ball.h"
+#include "../pong/Paddle.h"
+#include "../pong/Pong.h"
+
+#define BOARD_WIDTH 101
+#define BOARD_HEIGHT 31
+#define MIN_DURATION std::chrono::milliseconds(200)  // minimum time each benchmark is run for.
+#define HIGH_SCORES 10  // number of high scores read, as in the high scores menu.
+#define TRACE_FILE "bench-trace.json"  // trace written while benchmarking tracing, and removed afterwards.
+
+using timer = std::chrono::steady_clock;
+
+static std::atomic<long> allocationCount{0};
+
+/**
+ * @brief Replacement global allocation function, which counts every allocation made.
+ *
+ * @param size the number of bytes to allocate
+ * @return pointer to the allocated memory
+ */
+void *operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+/**
+ * @brief Replacement global deallocation function, matching the replacement allocation function.
+ *
+ * @param memory pointer to the memory to free
+ */
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+/**
+ * @brief Replacement sized global deallocation function, matching the replacement allocation function.
+ *
+ * @param memory pointer to the memory to free
+ */
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+/**
+ * @brief Declaration of `BenchmarkResult` structure.
+ *
+ * Holds the measurements of a single benchmark, averaged over every operation that was run.
+ */
+struct BenchmarkResult {
+    long operations;
+    double nanosecondsPerOp;
+    double allocationsPerOp;
+};
+
+/**
+ * @brief Static helper function runs an operation repeatedly and measures it.
+ *
+ * The operation is run once to warm up, and is then run in batches of doubling size until the total time taken
+ * exceeds the minimum duration. The wall clock time and number of allocations are averaged over every operation.
+ *
+ * @param operation the operation to be measured
+ * @return the measurements of the operation
+ */
+template<typename Operation>
+BenchmarkResult runBenchmark(Operation &&operation) {
+    operation();
+    long operations = 0;
+    long batchSize = 1;
+    long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    timer::time_point start = timer::now();
+    timer::duration elapsed{};
+    while (elapsed < MIN_DURATION) {
+        for (long i = 0; i < batchSize; i++) {
+            operation();
+        }
+        operations += batchSize;
+        batchSize *= 2;
+        elapsed = timer::now() - start;
+    }
+    long allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+    return {operations, nanoseconds / (double)operations, (double)allocations / (double)operations};
+}
+
+/**
+ * @brief Static helper function gets the configuration of the headless games benchmarked: AI versus AI on the hardest
+ * difficulty, with no score or time limit, so that a game never finishes while being stepped.
+ *
+ * @return the configuration, which benchmarks change only in the settings they vary
+ */
+static PongConfig headlessAIConfig() {
+    PongConfig config;
+    config.AICount = 2;
+    config.difficulty[0] = 3;
+    config.difficulty[1] = 3;
+    config.maxScore = 0;
+    config.maxTime = 0;
+    config.headless = true;
+    return config;
+}
+
+/**
+ * @brief Static helper function prints the header of the results table.
+ */
+void printHeader() {
+    std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(12) << "ops"
+              << std::setw(14) << "ns/op" << std::setw(12) << "allocs/op" << std::setw(14) << "bytes/frame"
+              << std::endl;
+}
+
+/**
+ * @brief Static helper function prints a row of the results table.
+ *
+ * @param name the name of the benchmark
+ * @param result the measurements of the benchmark
+ * @param bytesPerFrame the bytes written per frame, or a negative value if the benchmark does not render
+ */
+void printResult(const std::string &name, const BenchmarkResult &result, double bytesPerFrame = -1) {
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << result.operations
+              << std::fixed << std::setprecision(1) << std::setw(14) << result.nanosecondsPerOp
+              << std::setprecision(2) << std::setw(12) << result.allocationsPerOp << std::setw(14);
+    if (bytesPerFrame < 0) {
+        std::cout << "-";
+    } else {
+        std::cout << std::setprecision(1) << bytesPerFrame;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Benchmarks a tick of a headless AI versus AI game of `Pong`, with tracking and with predictive AI paddles.
+ */
+void benchmarkPongTick() {
+    for (PaddleAI mode: {PaddleAI::TRACKING, PaddleAI::PREDICTIVE}) {
+        NullRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT);
+        BufferedInputSource input;
+        PongConfig config = headlessAIConfig();
+        config.AIMode = mode;
+        Pong pong(&renderer, config, &input);
+        std::string name = mode == PaddleAI::TRACKING ? "tracking" : "predictive";
+        printResult("Pong::tick (headless, " + name + " AI)", runBenchmark([&pong]() { pong.step(); }));
+    }
+}
+
+/**
+ * @brief Benchmarks the cost of timing a game: a tick of a timed headless game, recording a duration into a
+ * `LatencyHistogram`, and summarising the timings for the overlay.
+ */
+void benchmarkGameStats() {
+    NullRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT);
+    BufferedInputSource input;
+    PongConfig config = headlessAIConfig();
+    Pong pong(&renderer, config, &input);
+    GameStats stats;
+    pong.setStats(&stats, false);
+    printResult("Pong::tick (headless, timed)", runBenchmark([&pong]() { pong.step(); }));
+
+    LatencyHistogram histogram;
+    std::uint64_t duration = 0;
+    printResult("LatencyHistogram::record", runBenchmark([&histogram, &duration]() {
+        histogram.record(duration);
+        duration = (duration * 7 + 1013) % 1000000;
+    }));
+    printResult("GameStats::getOverlay", runBenchmark([&stats]() { stats.getOverlay(); }));
+}
+
+/**
+ * @brief Benchmarks `Paddle::update` for tracking and predictive AI paddles, as the ball changes course every tick and
+ * as it keeps its course.
+ *
+ * The ball is not moved, so a course change is simulated by flipping its vertical velocity before every update.
+ */
+void benchmarkPaddleUpdate() {
+    for (PaddleAI mode: {PaddleAI::TRACKING, PaddleAI::PREDICTIVE}) {
+        for (bool changeCourse: {false, true}) {
+            EntityRegistry registry;
+            SpatialGrid grid(BOARD_WIDTH, BOARD_HEIGHT);
+            Ball ball(registry, BOARD_WIDTH / 2.0f, BOARD_HEIGHT / 2.0f, 1, 1, 1, 1, Colour::TERMINAL_DEFAULT);
+            Paddle paddle(registry, BOARD_WIDTH - 2, BOARD_HEIGHT / 2.0f, 0, 0, 1, 7, Colour::BLUE, true, 3, mode);
+            paddle.track(ball.getHandle());
+            std::string name = std::string(mode == PaddleAI::TRACKING ? "tracking" : "predictive") +
+                               (changeCourse ? ", new course" : ", same course");
+            printResult("Paddle::update (" + name + ")", runBenchmark([&]() {
+                if (changeCourse) {
+                    registry.setYVelocity(ball.getHandle(), -registry.getYVelocity(ball.getHandle()));
+                }
+                paddle.update(grid, BOARD_WIDTH, BOARD_HEIGHT);
+            }));
+        }
+    }
+}
+
+/**
+ * @brief Benchmarks a second of play of a headless AI versus AI game of `Pong` at tick rates from 20 to 240 ticks per
+ * second, with a frame composed 60 times per second, or every tick below that, as the paced game loop would.
+ *
+ * The cost per second of play is the cost the tick rate adds to the game loop, so it shows how high the tick rate can
+ * be set. Composing a frame is also measured on its own.
+ */
+void benchmarkTickRates() {
+    for (int tickRate: {20, 60, 120, 240}) {
+        NullRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT);
+        BufferedInputSource input;
+        PongConfig config = headlessAIConfig();
+        config.tickRate = tickRate;
+        Pong pong(&renderer, config, &input);
+        int ticksPerFrame = tickRate / std::min(tickRate, 60);
+        printResult("Pong, 1 s of play at " + std::to_string(tickRate) + " Hz (headless)", runBenchmark([&]() {
+            for (int tick = 1; tick <= tickRate; tick++) {
+                pong.step();
+                if (tick % ticksPerFrame == 0) {
+                    renderer.draw(pong.composeFrame());
+                }
+            }
+        }));
+        if (tickRate == 20) {
+            printResult("Pong::composeFrame", runBenchmark([&pong]() { pong.composeFrame(); }));
+        }
+    }
+}
+
+/**
+ * @brief Benchmarks restarting a headless game of `Pong` and playing a short match.
+ *
+ * The same game is restarted for every match, as a batch of headless matches would be.
+ */
+void benchmarkPongRestart() {
+    NullRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT);
+    BufferedInputSource input;
+    PongConfig config = headlessAIConfig();
+    config.maxTicks = 100;
+    Pong pong(&renderer, config, &input);
+    printResult("Pong::restart and 100 ticks (headless)", runBenchmark([&pong]() {
+        pong.restart();
+        pong.runGameLoop();
+    }));
+}
+
+/**
+ * @brief Benchmarks the collision checks of `Ball::update` against a varying number of other entities.
+ *
+ * The other entities are single cell paddles scattered across the board, as bricks would be, and are found through a
+ * broadphase grid. The ball is returned to the same position and velocity before every update so that each operation
+ * does the same work.
+ */
+void benchmarkBallUpdate() {
+    for (int entityCount: {2, 10, 100, 1000}) {
+        // The other entities are kept in their own registry, so that integrating the ball does not move them.
+        EntityRegistry registry;
+        EntityRegistry obstacles;
+        Ball ball(registry, BOARD_WIDTH / 2.0f, BOARD_HEIGHT / 2.0f, 1, 1, 1, 1, Colour::WHITE);
+        SpatialGrid grid(BOARD_WIDTH, BOARD_HEIGHT);
+        grid.insert(&ball);
+        std::vector<Paddle *> paddles;
+        for (int i = 0; i < entityCount; i++) {
+            int cell = (int)(((long)i * 7919) % (BOARD_WIDTH * BOARD_HEIGHT));
+            paddles.push_back(new Paddle(obstacles, (float)(cell % BOARD_WIDTH), (float)(cell / BOARD_WIDTH), 0, 0, 1,
+                                         1, Colour::WHITE, false, -1));
+            grid.insert(paddles.back());
+        }
+        BenchmarkResult result = runBenchmark([&]() {
+            ball.setX(BOARD_WIDTH / 2.0f);
+            ball.setY(BOARD_HEIGHT / 2.0f);
+            ball.setXVelocity(1);
+            ball.setYVelocity(1);
+            ball.update(grid, BOARD_WIDTH, BOARD_HEIGHT);
+            registry.integrate(BOARD_HEIGHT);
+        });
+        printResult("Ball::update (" + std::to_string(entityCount) + " other entities)", result);
+        for (Paddle *paddle: paddles) {
+            delete paddle;
+        }
+    }
+}
+
+/**
+ * @brief Benchmarks moving 1000 particles for a tick with the vector and scalar physics kernels.
+ *
+ * The particles bounce off the top and bottom of the board, and are moved through `EntityRegistry::integrate`.
+ */
+void benchmarkIntegrate() {
+    EntityRegistry registry;
+    for (int i = 0; i < 1000; i++) {
+        EntityHandle handle = registry.create((float)(i % BOARD_WIDTH), (float)(i % BOARD_HEIGHT),
+                                              (float)(i % 7 - 3) / 3, (float)(i % 5 - 2) / 2, 1, 1, ' ', Colour::WHITE);
+        registry.setBoundary(handle, BOUNDARY_REFLECT);
+    }
+    printResult(std::string("EntityRegistry::integrate (1000 particles, ") + getPhysicsKernelName() + ")",
+                runBenchmark([&registry]() { registry.integrate(BOARD_HEIGHT); }));
+    std::vector<float> x(1000), y(1000), xVelocity(1000), yVelocity(1000), remainingTime(1000, 1), height(1000, 1);
+    std::vector<std::int32_t> boundary(1000, BOUNDARY_REFLECT);
+    for (int i = 0; i < 1000; i++) {
+        x[i] = (float)(i % BOARD_WIDTH);
+        y[i] = (float)(i % BOARD_HEIGHT);
+        xVelocity[i] = (float)(i % 7 - 3) / 3;
+        yVelocity[i] = (float)(i % 5 - 2) / 2;
+    }
+    EntityArrays arrays{x.data(), y.data(), xVelocity.data(), yVelocity.data(), remainingTime.data(), height.data(),
+                        boundary.data(), 1000};
+    printResult("integrateEntitiesScalar (1000 particles)", runBenchmark([&arrays]() {
+        integrateEntitiesScalar(arrays, BOARD_HEIGHT);
+    }));
+}
+
+/**
+ * @brief Benchmarks removing and redrawing a paddle on the game board with `Pong::updateBoard`, as composing a frame
+ * draws each entity.
+ */
+void benchmarkUpdateBoard() {
+    FrameBuffer gameBoard(BOARD_WIDTH, BOARD_HEIGHT);
+    EntityRegistry registry;
+    Paddle paddle(registry, 1, BOARD_HEIGHT / 2.0f, 0, 0, 1, 7, Colour::WHITE, false, -1);
+    Cell cell = paddle.getCell();
+    printResult("Pong::updateBoard (paddle)", runBenchmark([&]() {
+        Pong::updateBoard(&gameBoard, &paddle, 1, 7, FrameBuffer::EMPTY_CELL);
+        Pong::updateBoard(&gameBoard, &paddle, 1, 7, cell);
+    }));
+}
+
+/**
+ * @brief Benchmarks `ConsoleRenderer::draw` writing to `/dev/null`.
+ *
+ * The typical frame moves only the ball, while the worst case frame alternates between two boards which differ in
+ * every cell. The bytes written per frame are measured by the renderer. The worst case is also passed through a
+ * `ThreadedRenderer`, to measure the cost seen by the game loop when frames are drawn on a render thread.
+ */
+void benchmarkConsoleDraw() {
+    int fd = open("/dev/null", O_WRONLY);
+    if (fd < 0) {
+        std::perror("/dev/null");
+        return;
+    }
+    {
+        ConsoleRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT, fd);
+        FrameBuffer gameBoard(BOARD_WIDTH, BOARD_HEIGHT);
+        EntityRegistry registry;
+        Ball ball(registry, BOARD_WIDTH / 2.0f, BOARD_HEIGHT / 2.0f, 1, 0, 1, 1, Colour::WHITE);
+        renderer.draw(gameBoard);
+        long bytesBefore = renderer.getBytesWritten();
+        BenchmarkResult result = runBenchmark([&]() {
+            Pong::updateBoard(&gameBoard, &ball, 1, 1, FrameBuffer::EMPTY_CELL);
+            ball.setX(ball.getX() + 1 < BOARD_WIDTH ? ball.getX() + 1 : 0);
+            Pong::updateBoard(&gameBoard, &ball, 1, 1, ball.getCell());
+            renderer.draw(gameBoard);
+        });
+        // The warm up operation is included in the bytes written.
+        printResult("ConsoleRenderer::draw (ball moved)", result,
+                    (double)(renderer.getBytesWritten() - bytesBefore) / (double)(result.operations + 1));
+    }
+    {
+        ConsoleRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT, fd);
+        FrameBuffer boards[2] = {FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'#', Colour::RED}),
+                                 FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'.', Colour::BLUE})};
+        int next = 0;
+        renderer.draw(boards[1]);
+        long bytesBefore = renderer.getBytesWritten();
+        BenchmarkResult result = runBenchmark([&]() {
+            renderer.draw(boards[next]);
+            next = 1 - next;
+        });
+        printResult("ConsoleRenderer::draw (every cell changed)", result,
+                    (double)(renderer.getBytesWritten() - bytesBefore) / (double)(result.operations + 1));
+    }
+    {
+        // Only the time taken to pass each frame to the render thread is measured, as the game loop would see it.
+        ThreadedRenderer renderer(new ConsoleRenderer(BOARD_WIDTH, BOARD_HEIGHT, fd));
+        FrameBuffer boards[2] = {FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'#', Colour::RED}),
+                                 FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'.', Colour::BLUE})};
+        int next = 0;
+        printResult("ThreadedRenderer::draw (every cell changed)", runBenchmark([&]() {
+            renderer.draw(boards[next]);
+            next = 1 - next;
+        }));
+    }
+    close(fd);
+}
+
+/**
+ * @brief Benchmarks full refreshes of the dot matrix, written to a memory-mapped file standing in for the device.
+ *
+ * The file is created in the temporary directory, in memory where that is a tmpfs, and is removed afterwards.
+ */
+void benchmarkDotMatrixDraw() {
+    std::string path = (std::filesystem::temp_directory_path() / "bench-matrix").string();
+    {
+        DotMatrixRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT, path);
+        FrameBuffer boards[2] = {FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'#', Colour::RED}),
+                                 FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'.', Colour::BLUE})};
+        int next = 0;
+        printResult("DotMatrixRenderer::draw (full refresh)", runBenchmark([&]() {
+            renderer.draw(boards[next]);
+            next = 1 - next;
+        }));
+    }
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Benchmarks exporting frames through shared memory, drawing through a `NullRenderer`, and reading them back.
+ */
+void benchmarkSharedMemoryExport() {
+    SharedMemoryRenderer renderer("bench-" + std::to_string(getpid()), new NullRenderer(BOARD_WIDTH, BOARD_HEIGHT));
+    FrameBuffer boards[2] = {FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'#', Colour::RED}),
+                             FrameBuffer(BOARD_WIDTH, BOARD_HEIGHT, {'.', Colour::BLUE})};
+    int next = 0;
+    printResult("SharedMemoryRenderer::draw", runBenchmark([&]() {
+        renderer.draw(boards[next]);
+        next = 1 - next;
+    }));
+
+    int fd = shm_open(renderer.getName().c_str(), O_RDONLY, 0);
+    struct stat status{};
+    fstat(fd, &status);
+    void *memory = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    const auto *header = static_cast<const SharedFrameHeader *>(memory);
+    FrameBuffer frame(BOARD_WIDTH, BOARD_HEIGHT);
+    std::uint64_t frameNumber;
+    printResult("SharedMemoryRenderer::readFrame", runBenchmark([&]() {
+        SharedMemoryRenderer::readFrame(header, frame.row(0), frameNumber);
+    }));
+    munmap(memory, status.st_size);
+    close(fd);
+}
+
+/**
+ * @brief Benchmarks reading the high scores menu from files of 10 to 1,000,000 scores, and recording a score in them.
+ *
+ * Each file is generated under the scores directory as a text file of the format stored by earlier versions, which is
+ * migrated by the warm up read, and both files are removed afterwards. A new `ScoreRecorder` is constructed for every
+ * read, as it is by the high scores menu, and each score written is appended to the same file.
+ */
+void benchmarkGetHighScores() {
+    for (int lineCount: {10, 1000, 100000, 1000000}) {
+        std::string filename = "bench-" + std::to_string(lineCount);
+        std::string legacyPath = "scores/" + filename + ".high";
+        std::string path = "scores/" + filename + ".scores";
+        {
+            std::ofstream file(legacyPath, std::ios::trunc);
+            for (int i = 0; i < lineCount; i++) {
+                file << (i * 7919) % 1000 << " - player" << i << "\n";
+            }
+        }
+        BenchmarkResult result = runBenchmark([&filename]() {
+            ScoreRecorder scoreRecorder(filename);
+            scoreRecorder.getHighScores(HIGH_SCORES);
+        });
+        printResult("ScoreRecorder::getHighScores (" + std::to_string(lineCount) + " scores)", result);
+        {
+            ScoreRecorder scoreRecorder(filename);
+            int score = 0;
+            printResult("ScoreRecorder::writeScore (" + std::to_string(lineCount) + " scores)",
+                        runBenchmark([&scoreRecorder, &score]() {
+                            scoreRecorder.writeScore("AAA", score++ % 2000);
+                        }));
+        }
+        std::filesystem::remove(legacyPath);
+        std::filesystem::remove(path);
+    }
+}
+
+/**
+ * @brief Benchmarks the cost of tracing to the thread recording: a tick of a headless game and an empty span, while a
+ * trace is being written.
+ *
+ * The trace is written by the flush thread while the benchmarks run, and is removed afterwards. As a process can only
+ * write one trace, this must be the last benchmark which traces. The benchmarks record far faster than a game does, so
+ * events dropped while the buffer is full are reported.
+ */
+void benchmarkTracing() {
+    NullRenderer renderer(BOARD_WIDTH, BOARD_HEIGHT);
+    BufferedInputSource input;
+    PongConfig config = headlessAIConfig();
+    Pong pong(&renderer, config, &input);
+    if (!TraceWriter::start(TRACE_FILE)) {
+        std::cerr << "Unable to write " << TRACE_FILE << std::endl;
+        return;
+    }
+    printResult("Pong::tick (headless, traced)", runBenchmark([&pong]() { pong.step(); }));
+    printResult("TraceSpan (traced)", runBenchmark([]() { TraceSpan span("bench", "bench"); }));
+    TraceWriter::stop();
+    std::cout << "    traced " << TraceWriter::getWrittenCount() << " events, dropped "
+              << TraceWriter::getDroppedCount() << std::endl;
+    std::filesystem::remove(TRACE_FILE);
+}
+
+/**
+ * @brief Main function runs every benchmark and prints the results.
+ *
+ * Must be run from the project root directory, so that the scores directory can be found.
+ *
+ * @return the exit status of the program
+ */
+int main() {
+    printHeader();
+    benchmarkPongTick();
+    benchmarkTickRates();
+    benchmarkGameStats();
+    benchmarkTracing();
+    benchmarkPongRestart();
+    benchmarkPaddleUpdate();
+    benchmarkBallUpdate();
+    benchmarkIntegrate();
+    benchmarkUpdateBoard();
+    benchmarkConsoleDraw();
+    benchmarkDotMatrixDraw();
+    benchmarkSharedMemoryExport();
+    benchmarkGetHighScores();
+    return 0;
+}
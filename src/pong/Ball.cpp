@@ -6,17 +6,21 @@
  * @date 30/10/21
  */
 
+#include <algorithm>
+#include <limits>
 #include "Ball.h"
 
 #define CHAR "\u2B24"
 #define PI 3.14159265
+#define MAX_CONTACTS 4  // maximum number of contacts resolved in a single tick.
 
 /**
  * @brief Basic constructor.
  *
- * The constructor for abstract superclass `Entity` is called with the provided parameters. There is no additional
- * implementation.
+ * The constructor for abstract superclass `Entity` is called with the provided parameters. The ball leaves paddles at
+ * a speed of a cell per tick, and does not speed up, until its speed is set.
  *
+ * @param registry the registry the state of the ball is stored in
  * @param x the initial x coordinate of the ball
  * @param y the initial y coordinate of the ball
  * @param xVelocity the initial x velocity of the ball
@@ -25,8 +29,14 @@
  * @param height the initial height of the ball
  * @param colour the colour of the ball (if applicable)
  */
-Ball::Ball(float x, float y, float xVelocity, float yVelocity, float width, float height, const Colour &colour)
-        : Entity(x, y, xVelocity, yVelocity, width, height, CHAR, colour) {}
+Ball::Ball(EntityRegistry &registry, float x, float y, float xVelocity, float yVelocity, float width, float height,
+           const Colour &colour)
+        : Entity(registry, x, y, xVelocity, yVelocity, width, height, CHAR, colour) {
+    this->speed = 1;
+    this->baseSpeed = 1;
+    this->speedRamp = 1;
+    this->maxSpeed = 1;
+}
 
 /**
 * @brief Default destructor.
@@ -36,91 +46,131 @@ Ball::Ball(float x, float y, float xVelocity, float yVelocity, float width, floa
 Ball::~Ball() = default;
 
 /**
- * @brief Updates the position of the ball given other entities in the current instance of `Game`.
+ * @brief Resolves the collisions of the ball with other entities in the current instance of `Game`.
  *
- * The position of the ball is updated, with pre and post-collision checks taking place to ensure collisions occur
- * correctly.
+ * The ball is swept along its velocity for the time it has remaining in the tick. The first contact with either the
+ * top or bottom wall of the board or another entity is found exactly, the ball is advanced to the point of contact and
+ * the collision is handled, and the ball is then swept again for the remainder of the tick. Contacts are therefore
+ * never missed, whatever the speed of the ball. Only the entities the grid finds near the path of the ball are swept
+ * against. The remainder of the tick after the last contact is integrated by the registry.
  *
- * @param entities the entities currently on the game board
+ * @param grid the broadphase grid of the entities on the game board
  * @param boardWidth the width of the board
  * @param boardHeight the height of the board
  */
-void Ball::update(const std::map<std::string, Entity *> &entities, int boardWidth, int boardHeight) {
-    // Pre-collision checking of the position after moving
-    float nextPositionX = x + xVelocity;
-    float nextPositionY = y + yVelocity;
-
-    // Checking the collision of the ball against the walls of the game board.
-    if (nextPositionY < 0 || nextPositionY >= boardHeight) {
-        yVelocity = -yVelocity;
-    }
-
-    // Checks what the entity is colliding with, and reacts accordingly.
-
-    int interpolate = 20;
-
-    for (auto const &ent: entities) {
-        if (ent.first == "ball") {
-            continue;
+void Ball::update(const SpatialGrid &grid, int boardWidth, int boardHeight) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    // The walls lie along the outer edges of the top and bottom rows of the board.
+    const Bounds walls[2] = {{-infinity, -infinity, infinity, -0.5f},
+                             {-infinity, boardHeight - 0.5f, infinity, infinity}};
+    for (int contacts = 0; contacts < MAX_CONTACTS && getRemainingTime() > 0; contacts++) {
+        float xVelocity = getXVelocity();
+        float yVelocity = getYVelocity();
+        float remaining = getRemainingTime();
+        Contact first{remaining, 0, 0};
+        Entity *collided = nullptr;
+        bool found = false;
+        Contact contact{};
+        Bounds bounds = getBounds();
+        for (const Bounds &wall: walls) {
+            if (sweep(bounds, xVelocity, yVelocity, wall, first.time, contact)) {
+                first = contact;
+                collided = nullptr;
+                found = true;
+            }
         }
-
-        float xl2 = ent.second->getX() - (ent.second->getWidth() / 2);
-        float xr2 = ent.second->getX() + (ent.second->getWidth() / 2);
-        float yt2 = ent.second->getY() + (ent.second->getHeight() / 2);
-        float yb2 = ent.second->getY() - (ent.second->getHeight() / 2);
-
-        if(interpolate > 0){
-            for(int i = 0; i <= interpolate; i++){
-                float xl1 = (nextPositionX - (width / 2));
-                float xr1 = (nextPositionX + (width / 2));
-                float yt1 = (nextPositionY - (height / 2));
-                float yb1 = (nextPositionY + (height / 2));
-                if(xVelocity >= 0){
-                    xl1 -= ((xVelocity / interpolate) * i);
-                    xr1 -= ((xVelocity / interpolate) * i);
-                    yt1 -= ((yVelocity / interpolate) * i);
-                    yb1 -= ((yVelocity / interpolate) * i);
-                }else{
-                    xl1 += ((xVelocity / interpolate) * i);
-                    xr1 += ((xVelocity / interpolate) * i);
-                    yt1 += ((yVelocity / interpolate) * i);
-                    yb1 += ((yVelocity / interpolate) * i);
-                }
-
-                if((xl1 >= xl2 && xl1 <= xr2) || (xr1 <= xr2 && xr1 >= xl2)){
-                    if((yt1 <= yt2 && yt1 >= yb2) || (yt1 >= yt2 && yb1 <= yb2)){
-                        onCollision(ent.second);
-                        break;
-                    }
-                }
+        float xDistance = xVelocity * remaining;
+        float yDistance = yVelocity * remaining;
+        Bounds path = {bounds.left + std::min(xDistance, 0.0f), bounds.top + std::min(yDistance, 0.0f),
+                       bounds.right + std::max(xDistance, 0.0f), bounds.bottom + std::max(yDistance, 0.0f)};
+        // The search is widened by a cell on each side to find entities moving up to a cell per tick.
+        path = {path.left - 1, path.top - 1, path.right + 1, path.bottom + 1};
+        for (Entity *candidate: grid.query(path)) {
+            if (candidate != this && sweep(candidate, first.time, contact)) {
+                first = contact;
+                collided = candidate;
+                found = true;
             }
         }
+        if (!found) {
+            break;
+        }
+        advance(first.time);
+        if (collided != nullptr) {
+            onCollision(collided);
+        } else {
+            setYVelocity(-yVelocity);
+        }
     }
-
-    // Post-collision checking of the position after moving.
-    nextPositionX = x + xVelocity;
-    nextPositionY = y + yVelocity;
-    x = nextPositionX;
-    y = nextPositionY;
 }
 
 /**
  * @brief Handles the ball colliding with another entity.
  *
- * Performs changes required to the ball state when it collides with a given entity.
+ * Performs changes required to the ball state when it collides with a given entity. The speed of the ball is ramped up,
+ * and the ball leaves the entity at that speed, at an angle set by where it struck the entity.
  *
  * @param collided the entity the ball collided with
  */
 void Ball::onCollision(Entity *collided) {
     if (collided != nullptr) {
-        float nextPositionY = y + yVelocity;
+        float xVelocity = getXVelocity();
+        float yVelocity = getYVelocity();
+        float nextPositionY = getY() + yVelocity;
 
         float rad = 90.0f * (PI/180.0f);
 
         float difference = (((nextPositionY - collided->getY()) / (collided->getHeight() / 2.0f)) * 45.0f) * (PI/180.0f);
         rad += difference;
         
-        xVelocity = xVelocity < 0 ? std::sin(rad) : -std::sin(rad);
-        yVelocity = yVelocity < 0 ? std::cos(rad) : -std::cos(rad);
+        speed = std::min(speed * speedRamp, maxSpeed);
+        setXVelocity(speed * (xVelocity < 0 ? std::sin(rad) : -std::sin(rad)));
+        setYVelocity(speed * (yVelocity < 0 ? std::cos(rad) : -std::cos(rad)));
+    }
+}
+
+/**
+ * @brief Sets the speed the ball is served at and how it speeds up, and resets its speed without changing its velocity.
+ *
+ * @param speed the speed the ball is served at, in cells per tick
+ * @param speedRamp the factor the speed of the ball is multiplied by each time it strikes a paddle
+ * @param maxSpeed the maximum speed of the ball, in cells per tick
+ */
+void Ball::setSpeed(float speed, float speedRamp, float maxSpeed) {
+    this->baseSpeed = speed;
+    this->speedRamp = speedRamp;
+    this->maxSpeed = maxSpeed;
+    this->speed = speed;
+}
+
+/**
+ * @brief Resets the speed of the ball to the speed it is served at, as at the start of a rally.
+ *
+ * The velocity of the ball is scaled by the same factor as its speed, so its direction is kept.
+ */
+void Ball::resetSpeed() {
+    if (speed != baseSpeed) {
+        setXVelocity(getXVelocity() * baseSpeed / speed);
+        setYVelocity(getYVelocity() * baseSpeed / speed);
     }
+    speed = baseSpeed;
+}
+
+/**
+ * @brief Getter for the speed of the ball, which is the speed it left the last paddle it struck at, or the speed it is
+ * served at if it has not struck a paddle since it was served.
+ *
+ * @return the speed of the ball, in cells per tick
+ */
+float Ball::getSpeed() const {
+    return speed;
+}
+
+/**
+ * @brief Getter for the speed the ball is served at.
+ *
+ * @return the speed the ball is served at, in cells per tick
+ */
+float Ball::getBaseSpeed() const {
+    return baseSpeed;
 }
@@ -9,17 +9,39 @@
 #ifndef BALL_H
 #define BALL_H
 
-#include "../Entity.h"
+#include "../SpatialGrid.h"
 
+/**
+ * @brief Declaration for concrete `Ball` class.
+ *
+ * Class provides implementation of entity `Ball` which inherits from abstract superclass `Entity`. The ball leaves a
+ * paddle at its current speed, which is then multiplied by its speed ramp, up to its maximum speed, so that it speeds
+ * up through a rally. Bouncing off a wall does not change its speed.
+ */
 class Ball : public Entity {
+private:
+    float speed;
+    float baseSpeed;
+    float speedRamp;
+    float maxSpeed;
+
 public:
-    Ball(float x, float y, float xVelocity, float yVelocity, float width, float height, const Colour &colour);
+    Ball(EntityRegistry &registry, float x, float y, float xVelocity, float yVelocity, float width, float height,
+         const Colour &colour);
 
     ~Ball() override;
 
-    void update(const std::map<std::string, Entity *> &entities, int boardWidth, int boardHeight) override;
+    void update(const SpatialGrid &grid, int boardWidth, int boardHeight) override;
 
     void onCollision(Entity *collided) override;
+
+    void setSpeed(float speed, float speedRamp, float maxSpeed);
+
+    void resetSpeed();
+
+    float getSpeed() const;
+
+    float getBaseSpeed() const;
 };
 
 #endif
@@ -6,16 +6,26 @@
  * @date 08/11/21
  */
 
+#include <algorithm>
+#include <cmath>
 #include "Paddle.h"
 
 #define CHAR "\u2588"
+#define STEER_TOLERANCE 0.5f  // distance from its target within which a predictive AI paddle stops.
+
+// Ticks at the base tick rate taken by a predictive AI to react to the ball changing course, and the most its aim may
+// be off by in rows, for each difficulty from 0 (easy) to 3 (extreme).
+static const int REACTION_DELAYS[4] = {8, 5, 2, 0};
+static const float AIM_ERRORS[4] = {7.0f, 5.0f, 4.0f, 0.0f};
 
 /**
  * @brief Basic constructor.
  *
- * The constructor for abstract superclass `Entity` is called with the provided parameters. There is no additional
- * implementation.
+ * The constructor for abstract superclass `Entity` is called with the provided parameters. The paddle is kept on the
+ * board by the registry, and tracks no ball until one is provided. The AI starts from the same state in every game, so
+ * that games can be replayed exactly.
  *
+ * @param registry the registry the state of the paddle is stored in
  * @param x the initial x coordinate of the paddle
  * @param y the initial y coordinate of the paddle
  * @param xVelocity the initial x velocity of the paddle
@@ -23,11 +33,31 @@
  * @param width the initial width of the paddle
  * @param height the initial height of the paddle
  * @param colour the colour of the paddle (if applicable)
+ * @param isAI true if the paddle is controlled by the AI
+ * @param difficulty the difficulty of the AI, from 0 (easy) to 3 (extreme)
+ * @param mode how the AI chooses where to move, if the paddle is controlled by the AI
+ * @param tickRate the tick rate of the game, in ticks per second
  */
-Paddle::Paddle(float x, float y, float xVelocity, float yVelocity, float width, float height, const Colour &colour, bool isAI, int difficulty)
-        : Entity(x, y, xVelocity, yVelocity, width, height, CHAR, colour) {
+Paddle::Paddle(EntityRegistry &registry, float x, float y, float xVelocity, float yVelocity, float width, float height,
+               const Colour &colour, bool isAI, int difficulty, PaddleAI mode /* = PaddleAI::TRACKING */,
+               int tickRate /* = BASE_TICK_RATE */)
+        : Entity(registry, x, y, xVelocity, yVelocity, width, height, CHAR, colour) {
+            float ticksPerBaseTick = (float)tickRate / BASE_TICK_RATE;
             this->isAI = isAI;
-            this->difficulty = ((3 - difficulty) * 4);
+            this->difficulty = (int)std::lround((3 - difficulty) * 4 * ticksPerBaseTick);
+            this->ball = INVALID_HANDLE;
+            this->tickCounter = 0;
+            this->mode = mode;
+            this->speed = 1 / ticksPerBaseTick;
+            this->reactionDelay = (int)std::lround(REACTION_DELAYS[std::clamp(difficulty, 0, 3)] * ticksPerBaseTick);
+            this->aimError = AIM_ERRORS[std::clamp(difficulty, 0, 3)];
+            this->reactionTicks = -1;
+            this->targetY = y;
+            this->lastBallX = 0;
+            this->courseXVelocity = 0;
+            this->courseYVelocity = 0;
+            this->courseCount = 0;
+            registry.setBoundary(handle, BOUNDARY_CLAMP);
         }
 
 /**
@@ -38,51 +68,125 @@ Paddle::Paddle(float x, float y, float xVelocity, float yVelocity, float width,
 Paddle::~Paddle() = default;
 
 /**
- * @brief Updates the position of the paddle given other entities in the current instance of `Game`.
+ * @brief Sets the ball followed by the paddle when it is controlled by the AI.
+ *
+ * @param ball the handle of the ball
+ */
+void Paddle::track(EntityHandle ball) {
+    this->ball = ball;
+}
+
+/**
+ * @brief Updates the velocity of the paddle given the ball it tracks.
+ *
+ * A tracking AI paddle moves towards the ball while the ball is moving towards it. A predictive AI paddle moves to the
+ * row it has predicted. The paddle is moved by the registry, which keeps it on the board.
  *
- * @param entity the entities currently on the game board
+ * @param grid the broadphase grid of the entities, which is not needed as the paddle only follows the ball
  * @param boardWidth the width of the board
  * @param boardHeight the height of the board
  */
-void Paddle::update(const std::map<std::string, Entity *> &entity, int boardWidth, int boardHeight) {
-    if(isAI){
-        if(difficulty==0 || tickCounter % difficulty == 0){
-            for(auto const &ent:entity){
-                if(ent.first == "ball") {
-                    if(ent.second->getX() < x && ent.second->getXVelocity() > 0 || ent.second->getX() > x && ent.second->getXVelocity() < 0){
-                        if(y < ent.second->getY() && (y+(height/2)) < (boardHeight-1)){
-                            yVelocity=1;
-                        }else if (y > ent.second->getY() && (y-(height/2))>0){
-                            yVelocity=-1;
-                        }else{
-                            yVelocity=0;
-                        }
-                    }else{
-                        yVelocity = 0;
-                    }
+void Paddle::update(const SpatialGrid &grid, int boardWidth, int boardHeight) {
+    if (isAI && mode == PaddleAI::PREDICTIVE && registry->isAlive(ball)) {
+        updatePredictive(boardHeight);
+    } else if (isAI && registry->isAlive(ball)) {
+        if (difficulty == 0 || tickCounter % difficulty == 0) {
+            float x = getX();
+            float y = getY();
+            float height = getHeight();
+            float ballX = registry->getX(ball);
+            float ballY = registry->getY(ball);
+            float ballXVelocity = registry->getXVelocity(ball);
+            if (ballX < x && ballXVelocity > 0 || ballX > x && ballXVelocity < 0) {
+                if (y < ballY && (y + (height / 2)) < (boardHeight - 1)) {
+                    setYVelocity(speed);
+                } else if (y > ballY && (y - (height / 2)) > 0) {
+                    setYVelocity(-speed);
+                } else {
+                    setYVelocity(0);
                 }
+            } else {
+                setYVelocity(0);
             }
         }
         tickCounter++;
     }
+}
 
-    if (yVelocity > 0) {
-        if (y + (height / 2) + yVelocity > boardHeight) {
-            y = boardHeight - (height / 2) - 1;
-        } else {
-            y = y + yVelocity;
-        }
-    } else if (yVelocity < 0) {
-        if (y - height / 2 + yVelocity < 0) {
-            y = y + (height / 2);
+/**
+ * @brief Updates the velocity of a predictive AI paddle.
+ *
+ * The ball has changed course if its velocity has changed, or if it has moved further than its velocity allows, as it
+ * does when it is served again without changing velocity. Once the reaction delay has passed since the ball last
+ * changed course, the paddle aims for the row at which the ball will reach it, off by up to its aim error, or for the
+ * middle of the board if the ball is moving away. Until then, it keeps moving towards its previous target. The ball's
+ * course is otherwise never predicted, so following it costs a comparison of its velocity each tick.
+ *
+ * @param boardHeight the height of the board
+ */
+void Paddle::updatePredictive(int boardHeight) {
+    float ballX = registry->getX(ball);
+    float xVelocity = registry->getXVelocity(ball);
+    float yVelocity = registry->getYVelocity(ball);
+    if (xVelocity != courseXVelocity || yVelocity != courseYVelocity ||
+        std::fabs(ballX - lastBallX) > std::fabs(xVelocity) + 1) {
+        courseXVelocity = xVelocity;
+        courseYVelocity = yVelocity;
+        courseCount++;
+        reactionTicks = reactionDelay;
+    }
+    lastBallX = ballX;
+    if (reactionTicks == 0) {
+        float x = getX();
+        if ((ballX < x && xVelocity > 0) || (ballX > x && xVelocity < 0)) {
+            // The error is drawn from a hash of the course, so that games remain deterministic.
+            std::uint64_t hash = ((std::uint64_t)courseCount << 32 | handle) * 0x9e3779b97f4a7c15ull;
+            hash ^= hash >> 31;
+            float error = aimError * ((float)(hash % 2001) / 1000.0f - 1.0f);
+            targetY = predictIntercept(boardHeight) + error;
         } else {
-            y = y + yVelocity;
+            targetY = (float)boardHeight / 2;
         }
+    }
+    if (reactionTicks >= 0) {
+        reactionTicks--;
+    }
+    float y = getY();
+    if (targetY > y + STEER_TOLERANCE) {
+        setYVelocity(speed);
+    } else if (targetY < y - STEER_TOLERANCE) {
+        setYVelocity(-speed);
     } else {
-        yVelocity = 0;
+        setYVelocity(0);
     }
 }
 
+/**
+ * @brief Predicts the row of the centre of the ball when it reaches the paddle, given its current course.
+ *
+ * The ball's path is unfolded across the walls: the row it would reach on an open board is folded back into the range
+ * of rows its centre can occupy, reflecting it at each wall it would bounce off.
+ *
+ * @param boardHeight the height of the board
+ * @return the row of the centre of the ball when it reaches the paddle
+ */
+float Paddle::predictIntercept(int boardHeight) const {
+    float ballHalfWidth = registry->getWidth(ball) / 2;
+    float ballHalfHeight = registry->getHeight(ball) / 2;
+    float contactX = getX() + (courseXVelocity > 0 ? -1.0f : 1.0f) * (getWidth() / 2 + ballHalfWidth);
+    float time = std::max((contactX - registry->getX(ball)) / courseXVelocity, 0.0f);
+    // The walls lie along the outer edges of the top and bottom rows of the board.
+    float low = -0.5f + ballHalfHeight;
+    float span = boardHeight - 0.5f - ballHalfHeight - low;
+    if (span <= 0) {
+        return low;
+    }
+    float offset = std::fmod(registry->getY(ball) + courseYVelocity * time - low, 2 * span);
+    if (offset < 0) {
+        offset += 2 * span;
+    }
+    return low + (offset > span ? 2 * span - offset : offset);
+}
 
 /**
  * @brief Handles the paddle colliding with another entity.
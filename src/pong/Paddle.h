@@ -9,26 +9,54 @@
 #ifndef PADDLE_H
 #define PADDLE_H
 
-#include "../Entity.h"
+#include <cstdint>
+#include "../SpatialGrid.h"
+#include "PongConfig.h"
 
 /**
  * @brief Declaration for concrete `Paddle` class.
  *
  * Class provides implementation of entity `Paddle` which inherits from abstract superclass `Entity`.
+ *
+ * A predictive AI paddle caches the row at which the ball will reach it, and only works it out again once the ball has
+ * changed course: when it bounces, is hit or is served. Its difficulty sets how many ticks it takes to react to a
+ * change of course and how far its aim may be off.
+ *
+ * An AI paddle moves at a cell per tick at the base tick rate. Its speed and reaction times are in real time, so they
+ * are scaled to the tick rate of the game.
  */
 class Paddle : public Entity {
 public:
-    Paddle(float x, float y, float xVelocity, float yVelocity, float width, float height, const Colour &colour, bool isAI, int difficulty);
+    Paddle(EntityRegistry &registry, float x, float y, float xVelocity, float yVelocity, float width, float height,
+           const Colour &colour, bool isAI, int difficulty, PaddleAI mode = PaddleAI::TRACKING,
+           int tickRate = BASE_TICK_RATE);
 
     ~Paddle() override;
 
-    void update(const std::map<std::string, Entity *> &entity, int boardWidth, int boardHeight) override;
+    void track(EntityHandle ball);
+
+    void update(const SpatialGrid &grid, int boardWidth, int boardHeight) override;
 
     void onCollision(Entity *collided) override;
 private:
     bool isAI;
     int difficulty;
     int tickCounter;
+    EntityHandle ball;
+    PaddleAI mode;
+    float speed;
+    int reactionDelay;
+    float aimError;
+    int reactionTicks;
+    float targetY;
+    float lastBallX;
+    float courseXVelocity;
+    float courseYVelocity;
+    std::uint32_t courseCount;
+
+    void updatePredictive(int boardHeight);
+
+    float predictIntercept(int boardHeight) const;
 };
 
 #endif
\ No newline at end of file
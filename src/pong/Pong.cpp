@@ -6,15 +6,20 @@
  * @date 07/11/21
  */
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include "../InputWatcher.h"
+#include "../FrameScheduler.h"
+#include "../TraceWriter.h"
 #include "Pong.h"
 #include "Ball.h"
 #include "Paddle.h"
+#include "PongReplay.h"
 
 #define SCORES_FILE "pong"
 
-#define EMPTY_INDEX std::make_pair(" ", Colour::TERMINAL_DEFAULT)
+#define EMPTY_INDEX FrameBuffer::EMPTY_CELL
 #define BALL_INIT_X (renderer->getWidth() / 2)
 #define BALL_INIT_Y (renderer->getHeight() / 2)
 #define BALL_INIT_X_VEL 1
@@ -27,94 +32,160 @@
 #define PADDLE_INIT_VEL 0
 #define PADDLE_INIT_WIDTH 1
 #define PADDLE_INIT_HEIGHT 7  // should be odd.
-#define TICK_LENGTH 50
+#define MAX_FRAME_RATE 60  // most frames displayed per second, however high the tick rate.
+#define MAX_CATCH_UP_TIME 250  // most time caught up at once after the process was descheduled, in milliseconds.
+#define MAX_SPEED_FACTOR 3.0f  // maximum speed of the ball, as a multiple of the speed it is served at.
 #define PAUSE 27
 #define P1_UP 'w'
 #define P1_DOWN 's'
 #define P2_UP 'u'
 #define P2_DOWN 'j'
+#define FNV_OFFSET_BASIS 14695981039346656037ull  // initial value of the 64 bit FNV-1a hash.
+#define FNV_PRIME 1099511628211ull  // multiplier of the 64 bit FNV-1a hash.
+#define SPLITMIX_INCREMENT 0x9e3779b97f4a7c15ull  // increment of the splitmix64 generator serves are drawn from.
 
 /**
  * @brief Executes a game tick.
  *
- * Each entity on the board is removed, updated and redrawn onto the board before the board is displayed to the user.
+ * The key presses read since the last tick are processed, with the arrow keys acting as player 2's keys. The behaviour
+ * of each entity is updated, the registry moves every entity for the rest of the tick, and each entity is moved within
+ * the broadphase grid. Nothing is drawn: the entities are drawn when a frame is composed, at the frame rate of the game
+ * loop. If the game is timed, the input and update are timed as separate phases.
  */
 void Pong::tick() {
+    int width = renderer->getWidth();
+    int height = renderer->getHeight();
     // Process user input.
-    char input;
-    while ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-        updateBoard(&gameBoard, entities["leftPaddle"], (int)entities["leftPaddle"]->getWidth(),
-                    (int)entities["leftPaddle"]->getHeight(), EMPTY_INDEX);
-        updateBoard(&gameBoard, entities["rightPaddle"], (int)entities["rightPaddle"]->getWidth(),
-                    (int)entities["rightPaddle"]->getHeight(), EMPTY_INDEX);
-        switch (input) {
-            case PAUSE:
-                gamePaused = true;
-                break;
-            case P1_UP:
-                if(this->AICount <= 1){
-                    if (entities["leftPaddle"]->getY() - 1 >= entities["leftPaddle"]->getHeight() / 2) {
-                       entities["leftPaddle"]->setY(entities["leftPaddle"]->getY() - 1);
+    {
+        GameStats::ScopedTimer timer(stats, Phase::INPUT);
+        input->drain(keyPresses);
+        for (const InputEvent &event: keyPresses) {
+            char key = event.character;
+            if (event.key == Key::UP) {
+                key = P2_UP;
+            } else if (event.key == Key::DOWN) {
+                key = P2_DOWN;
+            }
+            switch (key) {
+                case PAUSE:
+                    gamePaused = true;
+                    break;
+                case P1_UP:
+                    if (config.AICount <= 1) {
+                        movePaddle(leftPaddle, -1);
                     }
-                }
-                break;
-            case P1_DOWN:
-                if(this->AICount <= 1){
-                    if (entities["leftPaddle"]->getY() + 1 <=
-                        renderer->getHeight() - entities["leftPaddle"]->getHeight() / 2 - 1) {
-                        entities["leftPaddle"]->setY(entities["leftPaddle"]->getY() + 1);
+                    break;
+                case P1_DOWN:
+                    if (config.AICount <= 1) {
+                        movePaddle(leftPaddle, 1);
                     }
-                }
-                break;
-            case P2_UP:
-                if(this->AICount < 1){
-                    if (entities["rightPaddle"]->getY() - 1 >= entities["rightPaddle"]->getHeight() / 2) {
-                        entities["rightPaddle"]->setY(entities["rightPaddle"]->getY() - 1);
+                    break;
+                case P2_UP:
+                    if (config.AICount < 1) {
+                        movePaddle(rightPaddle, -1);
                     }
-                }
-                break;
-            case P2_DOWN:
-                if(this->AICount < 1){
-                    if (entities["rightPaddle"]->getY() + 1 <=
-                        renderer->getHeight() - entities["rightPaddle"]->getHeight() / 2 - 1) {
-                        entities["rightPaddle"]->setY(entities["rightPaddle"]->getY() + 1);
+                    break;
+                case P2_DOWN:
+                    if (config.AICount < 1) {
+                        movePaddle(rightPaddle, 1);
                     }
-                }
-            default:
-                break;
+                default:
+                    break;
+            }
         }
-        updateBoard(&gameBoard, entities["leftPaddle"], (int)entities["leftPaddle"]->getWidth(),
-                    (int)entities["leftPaddle"]->getHeight(), entities["leftPaddle"]->getDisplayPair());
-        updateBoard(&gameBoard, entities["rightPaddle"], (int)entities["rightPaddle"]->getWidth(),
-                    (int)entities["rightPaddle"]->getHeight(), entities["rightPaddle"]->getDisplayPair());
     }
     // Updates all entities on the board.
-    int count = -1;
-    for (auto const &entity: entities) {
-        int width = (int)entity.second->getWidth();
-        int height = (int)entity.second->getHeight();
-        updateBoard(&gameBoard, entity.second, width, height, EMPTY_INDEX);
-        entity.second->update(entities, renderer->getWidth(), renderer->getHeight());
-        if (entity.first == "ball") {
-            checkBallScored(entity.second);
+    {
+        GameStats::ScopedTimer timer(stats, Phase::UPDATE);
+        for (EntityHandle handle = 0; handle < registry.capacity(); handle++) {
+            Entity *entity = registry.getEntity(handle);
+            if (entity != nullptr) {
+                TraceSpan span(handle == ball ? "Ball::update" : "Paddle::update", "entity", "handle", handle);
+                entity->update(grid, width, height);
+            }
+        }
+        registry.integrate(height);
+        checkBallScored();
+        for (EntityHandle handle = 0; handle < registry.capacity(); handle++) {
+            Entity *entity = registry.getEntity(handle);
+            if (entity != nullptr) {
+                grid.update(entity);
+            }
+        }
+        if (gameFinished && !config.headless) {
+            timer.cancel();  // the winning point waits for the winner to enter their name.
         }
-        updateBoard(&gameBoard, entity.second, width, height, entity.second->getDisplayPair());
-        count++;
     }
+    checkTimeLimit();
+}
+
+/**
+ * @brief Composes the frame to be displayed: the game board, with the game time and scores, and every entity drawn
+ * over it at its position rounded to the nearest cell.
+ *
+ * If the timings overlay is enabled, the 99th percentile of each phase is written above the bottom of the frame,
+ * beneath the entities.
+ *
+ * @return the frame to be displayed, valid until the next call
+ */
+const FrameBuffer &Pong::composeFrame() {
     displayGameTime();
     displayScore();
-    renderer->draw(gameBoard);
+    frame.blit(gameBoard, 0, 0);
+    if (statsOverlay) {
+        frame.write(L_PADDLE_INIT_X + 2, frame.getHeight() - 2, stats->getOverlay(), Colour::TERMINAL_DEFAULT);
+    }
+    for (EntityHandle handle = 0; handle < registry.capacity(); handle++) {
+        Entity *entity = registry.getEntity(handle);
+        if (entity != nullptr) {
+            updateBoard(&frame, entity, (int)registry.getWidth(handle), (int)registry.getHeight(handle),
+                        entity->getCell());
+        }
+    }
+    return frame;
+}
+
+/**
+ * @brief Moves a paddle controlled by a player by a row.
+ *
+ * The paddle is kept on the board by the registry when the tick is integrated.
+ *
+ * @param paddle the handle of the paddle
+ * @param direction -1 to move the paddle up, or 1 to move it down
+ */
+void Pong::movePaddle(EntityHandle paddle, int direction) {
+    registry.setY(paddle, registry.getY(paddle) + (float)direction);
+}
+
+/**
+ * @brief Finishes the game once the time limit, if any, is reached.
+ *
+ * The winner is announced and, unless the game is headless, the game waits for a key press.
+ */
+void Pong::checkTimeLimit() {
+    if (maxTime != 0 && (long)tickCount / config.tickRate / 60 == maxTime) {
+        if (scores[0] == scores[1]) {
+            displayMessage("The game was a tie!", -2);
+        } else {
+            displayMessage("Congratulations player " + std::to_string(scores[0] > scores[1] ? 1 : 2) + ", you win!",
+                           -2);
+        }
+        if (!config.headless) {
+            displayMessage("Press any key to return to the main menu", 0);
+            renderer->draw(composeFrame());
+            input->waitForKey();
+        }
+        gameFinished = true;
+    }
 }
 
 /**
  * @brief Adds game time to game board.
  *
- * Uses the start time of the game compared to the current time to calculate the game time elapsed. This is added to the
- * middle of the board.
+ * The game time elapsed is calculated from the number of ticks run, and is added to the middle of the board.
  */
 void Pong::displayGameTime() {
-    int elapsed = tickCount * TICK_LENGTH;
-    long rawSeconds = elapsed / 1000;
+    long rawSeconds = (long)tickCount / config.tickRate;
     long minutes = rawSeconds / 60;
     long seconds = rawSeconds % 60;
     std::string minutesStr = std::to_string(minutes);
@@ -126,29 +197,16 @@ void Pong::displayGameTime() {
         secondsStr = "0" + secondsStr;
     }
     std::string gameTime = minutesStr + ":" + secondsStr;
-    if (maxTime != 0 && minutes == maxTime) {
-        if (scores[0] == scores[1]) {
-            displayMessage("The game was a tie!", -2);
-        } else {
-            displayMessage("Congratulations player " + std::to_string(scores[0] > scores[1] ? 1 : 2) + ", you win!",
-                           -2);
-        }
-        displayMessage("Press any key to return to the main menu", 0);
-        renderer->draw(gameBoard);
-        while (InputWatcher::getInstance().getKeyPress() == '\0');
-        gameFinished = true;
-    }
-    int middle = gameBoard[0].size() / 2;
-    for (int i = 0; i < gameTime.length(); i++) {
-        gameBoard[1][middle + i - 2] = std::make_pair(gameTime[i], Colour::TERMINAL_DEFAULT);
-    }
+    int middle = gameBoard.getWidth() / 2;
+    gameBoard.write(middle - 2, 1, gameTime, Colour::TERMINAL_DEFAULT);
 }
 
 /**
  * @brief Static helper function updates the game board for entities.
  *
- * With the provided game board, entity, width, height and pair of character and `Colour`, the game board is updated to
- * either add or remove the entity, by setting the values at its position to true or false respectively.
+ * With the provided game board, entity, width, height and cell of character and `Colour`, the game board is updated to
+ * either add or remove the entity, by setting the cells covered by the entity to the new value. Cells outside of the
+ * board are clipped. The position of the entity is rounded to the nearest cell.
  *
  * @param gameBoard pointer to the game board
  * @param entity the entity to be added/removed
@@ -156,14 +214,10 @@ void Pong::displayGameTime() {
  * @param height the height of the entity (passed to prevent repeated calls to getter in calling method)
  * @param newValue the value that the entities positions should be set to
  */
-void Pong::updateBoard(std::vector<std::vector<std::pair<std::string, Colour>>> *gameBoard, Entity *entity, int width,
-                 int height, const std::pair<std::string, Colour> &newValue) {
-    for (int x = (int)entity->getX() - ((width - 1) / 2); x <= (int)entity->getX() + (width - 1) / 2; x++) {
-        for (int y = (int)entity->getY() - ((height - 1) / 2); y <= (int)entity->getY() + (height - 1) / 2; y++) {
-            if(x >= renderer->getWidth() || y >= renderer->getHeight()) continue;
-            gameBoard->at(y).at(x) = newValue;
-        }
-    }
+void Pong::updateBoard(FrameBuffer *gameBoard, Entity *entity, int width, int height, const Cell &newValue) {
+    int left = (int)std::floor(entity->getX() + 0.5f) - ((width - 1) / 2);
+    int top = (int)std::floor(entity->getY() + 0.5f) - ((height - 1) / 2);
+    gameBoard->fill(left, top, (width - 1) / 2 * 2 + 1, (height - 1) / 2 * 2 + 1, newValue);
 }
 
 /**
@@ -179,15 +233,14 @@ int getAICountFromUser(Renderer *renderer) {
     renderer->displayMenu("Please select a game type:", {"You versus Human Opponent", "You versus AI", "AI versus AI"});
     char input;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            switch (input) {
-                case '1':
-                case '2':
-                case '3':
-                    return input - '0' - 1;
-                default:
-                    continue;
-            }
+        input = InputWatcher::getInstance().waitForKey();
+        switch (input) {
+            case '1':
+            case '2':
+            case '3':
+                return input - '0' - 1;
+            default:
+                continue;
         }
     }
 }
@@ -207,71 +260,81 @@ int getAIDifficultyFromUser(Renderer *renderer, int playerNo) {
                           {"Easy", "Moderate", "Hard", "Extreme"});
     char input;
     while (true) {
-        if ((input = InputWatcher::getInstance().getKeyPress()) != '\0') {
-            switch (input) {
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                    return input - '0' - 1;
-                default:
-                    continue;
-            }
+        input = InputWatcher::getInstance().waitForKey();
+        switch (input) {
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+                return input - '0' - 1;
+            default:
+                continue;
         }
     }
 }
 
 /**
- * @brief Constructor for new game instance using provided renderer .
+ * @brief Constructor for new game instance using provided renderer, prompting the user for the game type.
  *
- * The constructor for abstract superclass `Game` is called with the provided parameters. In addition, a game board is
- * initialised as a 2D vector of size provided by the renderer, with default values set to empty, and a vector of
- * required entities is also initialised.
+ * The user is asked for the number of AI players and their difficulties, before the game is constructed with the
+ * resulting configuration, reading input from the user's keystrokes.
  *
  * @param renderer the provided instance of `Renderer` to be used to display the game
  * @param maxScore the maximum score of the game
  * @param maxTime the maximum time of the game
+ * @param AIMode how AI paddles choose where to move
  */
-Pong::Pong(Renderer *renderer, int maxScore, int maxTime) : Game(renderer, SCORES_FILE, maxScore, maxTime) {
-    for (int y = 0; y < renderer->getHeight(); y++) {
-        std::vector<std::pair<std::string, Colour>> row;
-        for (int x = 0; x < renderer->getWidth(); x++) {
-            row.emplace_back(EMPTY_INDEX);
-        }
-        this->gameBoard.push_back(row);
-    }
+Pong::Pong(Renderer *renderer, int maxScore, int maxTime, PaddleAI AIMode /* = PaddleAI::TRACKING */)
+        : Pong(renderer, promptForConfig(renderer, maxScore, maxTime, AIMode), &InputWatcher::getInstance()) {}
 
-    this->AICount = getAICountFromUser(renderer);
-    this->difficulty[0] = this->AICount > 1 ? getAIDifficultyFromUser(renderer, 1) : -1;
-    this->difficulty[1] = this->AICount > 0 ? getAIDifficultyFromUser(renderer, 2) : -1;
+/**
+ * @brief Constructor for new game instance using provided renderer, configuration and input source.
+ *
+ * The constructor for abstract superclass `Game` is called with the provided parameters. In addition, a game board and
+ * the frame composed from it are initialised as frame buffers of size provided by the renderer, with default values set
+ * to empty, and the required entities are created. The tick rate and ball speed are clamped to the supported ranges.
+ * Unless the game is headless, instructions are then displayed until a key is pressed.
+ *
+ * @param renderer the provided instance of `Renderer` to be used to display the game
+ * @param config the settings of the game
+ * @param input the provided instance of `InputSource` the game's input is read from
+ */
+Pong::Pong(Renderer *renderer, const PongConfig &config, InputSource *input)
+        : Game(renderer, input, SCORES_FILE, config.maxScore, config.maxTime) {
+    this->config = config;
+    this->config.tickRate = std::clamp(config.tickRate, MIN_TICK_RATE, MAX_TICK_RATE);
+    this->config.ballSpeed = std::clamp(config.ballSpeed, MIN_BALL_SPEED, MAX_BALL_SPEED);
+    this->config.speedRamp = std::max(config.speedRamp, 0);
+    this->gameBoard = FrameBuffer(renderer->getWidth(), renderer->getHeight(), EMPTY_INDEX);
+    this->frame = FrameBuffer(renderer->getWidth(), renderer->getHeight(), EMPTY_INDEX);
 
-    this->entities["ball"] = new Ball(BALL_INIT_X, BALL_INIT_Y, BALL_INIT_X_VEL, BALL_INIT_Y_VEL, BALL_INIT_WIDTH,
-                                      BALL_INIT_HEIGHT, Colour::TERMINAL_DEFAULT);
-    this->entities["leftPaddle"] = new Paddle(L_PADDLE_INIT_X, PADDLE_INIT_Y, PADDLE_INIT_VEL, PADDLE_INIT_VEL,
-                                              PADDLE_INIT_WIDTH, PADDLE_INIT_HEIGHT, Colour::RED, AICount>=2, this->difficulty[0]);
-    this->entities["rightPaddle"] = new Paddle(R_PADDLE_INIT_X, PADDLE_INIT_Y, PADDLE_INIT_VEL, PADDLE_INIT_VEL,
-                                               PADDLE_INIT_WIDTH, PADDLE_INIT_HEIGHT, Colour::BLUE, AICount>=1, this->difficulty[1]);
+    createEntities();
 
     this->scores[0] = 0;
     this->scores[1] = 0;
 
+    if (this->config.headless) {
+        return;
+    }
+
     // Display "press any key" screen
     std::string instructionMessage = "score a point by bypassing your opponent's paddle!";
     std::string player1Message = "Player 1: use keys W and S to move your paddle up and down respectively";
-    std::string player2Message = "Player 2: use keys U and J to move your paddle up and down respectively";
+    std::string player2Message =
+            "Player 2: use keys U and J (or the arrow keys) to move your paddle up and down respectively";
     std::string pauseMessage = "Pause the game at any time using the escape key";
     std::string beginMessage = "Press any key to begin";
     displayMessage(instructionMessage, -6);
-    if (AICount < 2) {
+    if (config.AICount < 2) {
         displayMessage(player1Message, -4);
     }
-    if (AICount == 0) {
+    if (config.AICount == 0) {
         displayMessage(player2Message, -3);
     }
     displayMessage(pauseMessage, -2);
     displayMessage(beginMessage, 0);
     renderer->draw(gameBoard);
-    while (InputWatcher::getInstance().getKeyPress() == '\0');
+    input->waitForKey();
     clearMessage(instructionMessage.length(), -6);
     clearMessage(player1Message.length(), -4);  // Extra, unnecessary clears are OK.
     clearMessage(player2Message.length(), -3);
@@ -279,6 +342,75 @@ Pong::Pong(Renderer *renderer, int maxScore, int maxTime) : Game(renderer, SCORE
     clearMessage(beginMessage.length());
 }
 
+/**
+ * @brief Creates the ball and paddles in the arena and registry of the game.
+ *
+ * The handles of the entities are kept for the rest of the match, so they never need to be looked up by name. The
+ * generator serves are drawn from is reseeded, so that a restarted match plays out as the first did, and the ball is
+ * served. Velocities are in cells per tick, so the speed of the ball is divided by the tick rate.
+ */
+void Pong::createEntities() {
+    float ballSpeed = (float)config.ballSpeed / (float)config.tickRate;
+    auto *created = arena.create<Ball>(registry, BALL_INIT_X, BALL_INIT_Y, BALL_INIT_X_VEL * ballSpeed,
+                                       BALL_INIT_Y_VEL * ballSpeed, BALL_INIT_WIDTH, BALL_INIT_HEIGHT,
+                                       Colour::TERMINAL_DEFAULT);
+    created->setSpeed(ballSpeed, 1 + (float)config.speedRamp / 100, ballSpeed * MAX_SPEED_FACTOR);
+    this->ball = addEntity("ball", created);
+    auto *left = arena.create<Paddle>(registry, L_PADDLE_INIT_X, PADDLE_INIT_Y, PADDLE_INIT_VEL, PADDLE_INIT_VEL,
+                                      PADDLE_INIT_WIDTH, PADDLE_INIT_HEIGHT, Colour::RED, config.AICount >= 2,
+                                      config.difficulty[0], config.AIMode, config.tickRate);
+    auto *right = arena.create<Paddle>(registry, R_PADDLE_INIT_X, PADDLE_INIT_Y, PADDLE_INIT_VEL, PADDLE_INIT_VEL,
+                                       PADDLE_INIT_WIDTH, PADDLE_INIT_HEIGHT, Colour::BLUE, config.AICount >= 1,
+                                       config.difficulty[1], config.AIMode, config.tickRate);
+    left->track(ball);
+    right->track(ball);
+    this->leftPaddle = addEntity("leftPaddle", left);
+    this->rightPaddle = addEntity("rightPaddle", right);
+    this->serveState = config.seed;
+    serve();
+}
+
+/**
+ * @brief Restarts the game as a new match with the same settings, without prompting the user.
+ *
+ * The entities of the previous match are destroyed in one go and the new entities reuse their memory, as does the game
+ * board, so a restart requests no memory from the heap once the first match has been played.
+ */
+void Pong::restart() {
+    clearEntities();
+    gameBoard.fill(EMPTY_INDEX);
+    keyPresses.clear();
+    createEntities();
+    scores[0] = 0;
+    scores[1] = 0;
+    tickCount = 0;
+    gameFinished = false;
+    gamePaused = false;
+}
+
+/**
+ * @brief Prompts the user for the settings of a new game.
+ *
+ * The user will be asked for the number of AI players and the difficulty of each AI player.
+ *
+ * @param renderer the renderer used to display the prompts
+ * @param maxScore the maximum score of the game
+ * @param maxTime the maximum time of the game
+ * @param AIMode how AI paddles choose where to move
+ * @return the settings of the game
+ */
+PongConfig Pong::promptForConfig(Renderer *renderer, int maxScore, int maxTime,
+                                 PaddleAI AIMode /* = PaddleAI::TRACKING */) {
+    PongConfig config;
+    config.maxScore = maxScore;
+    config.maxTime = maxTime;
+    config.AIMode = AIMode;
+    config.AICount = getAICountFromUser(renderer);
+    config.difficulty[0] = config.AICount > 1 ? getAIDifficultyFromUser(renderer, 1) : -1;
+    config.difficulty[1] = config.AICount > 0 ? getAIDifficultyFromUser(renderer, 2) : -1;
+    return config;
+}
+
 /**
  * @brief Adds the score to the board.
  *
@@ -287,12 +419,10 @@ Pong::Pong(Renderer *renderer, int maxScore, int maxTime) : Game(renderer, SCORE
 void Pong::displayScore() {
     std::string score1 = std::to_string(scores[0]);
     std::string score2 = std::to_string(scores[1]);
-    int middle = gameBoard.size() / 2;
-    for (int i = 0; i < score1.length(); i++) {
-        gameBoard[middle][L_PADDLE_INIT_X + 2 + i] = std::make_pair(score1[i], Colour::TERMINAL_DEFAULT);
-    }
+    int middle = gameBoard.getHeight() / 2;
+    gameBoard.write(L_PADDLE_INIT_X + 2, middle, score1, Colour::TERMINAL_DEFAULT);
     for (int i = 0; i < score2.length(); i++) {
-        gameBoard[middle][R_PADDLE_INIT_X - 2 - i] = std::make_pair(score2[i], Colour::TERMINAL_DEFAULT);
+        gameBoard.at(R_PADDLE_INIT_X - 2 - i, middle) = {(GlyphId)score2[i], Colour::TERMINAL_DEFAULT};
     }
 }
 
@@ -310,54 +440,228 @@ void Pong::clearMessage(int length, int displacement /* = 0 */) {
  *
  * Given that the ball entity has updated it's position, we can determine whether or not
  * a score must be given to a player.
- *
- * @param ball pointer to a ball on the board
  */
-void Pong::checkBallScored(Entity *ball) {
-    if (ball->getX() <= 0) {
+void Pong::checkBallScored() {
+    if (registry.getX(ball) <= 0) {
         score(1);
-        ball->setX(BALL_INIT_X);
-        ball->setY(BALL_INIT_Y);
-    } else if (ball->getX() >= renderer->getWidth()) {
+        serve();
+    } else if (registry.getX(ball) >= renderer->getWidth()) {
         score(0);
-        ball->setX(BALL_INIT_X);
-        ball->setY(BALL_INIT_Y);
+        serve();
     }
 }
 
 /**
- * @brief Destructs instance of `Pong`.
+ * @brief Returns the ball to the centre of the board to be served.
  *
- * Deletes all instances of `Entity` created for this game.
+ * The speed of the ball is reset to the speed it is served at. With a seed of zero, the ball keeps its direction.
+ * Otherwise, the ball is served to the left or right at a slope of a half or one row per column, up or down, drawn from
+ * the generator seeded by the seed of the game.
  */
-Pong::~Pong() {
-    for (auto &entity: entities) {
-        delete entity.second;
+void Pong::serve() {
+    registry.setX(ball, BALL_INIT_X);
+    registry.setY(ball, BALL_INIT_Y);
+    auto *served = static_cast<Ball *>(registry.getEntity(ball));
+    served->resetSpeed();
+    if (config.seed == 0) {
+        return;
     }
+    float speed = served->getBaseSpeed();
+    std::uint64_t random = nextRandom();
+    registry.setXVelocity(ball, (random & 1) != 0 ? BALL_INIT_X_VEL * speed : -BALL_INIT_X_VEL * speed);
+    float yVelocity = (random & 2) != 0 ? BALL_INIT_Y_VEL * speed : BALL_INIT_Y_VEL * speed / 2.0f;
+    registry.setYVelocity(ball, (random & 4) != 0 ? yVelocity : -yVelocity);
 }
 
+/**
+ * @brief Draws the next number from the splitmix64 generator serves are drawn from.
+ *
+ * @return the number drawn
+ */
+std::uint64_t Pong::nextRandom() {
+    std::uint64_t value = (serveState += SPLITMIX_INCREMENT);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Destructs instance of `Pong`.
+ *
+ * The instances of `Entity` created for this game are deleted by `Game`.
+ */
+Pong::~Pong() = default;
+
 /**
  * @brief Runs game loop which operates game.
  *
- * Calls method `tick` to update the game. This method is called every 100 milliseconds. This happens by comparing the
- * current system time to the time `tick` was last called, calling it again after 100 milliseconds have elapsed.
+ * Calls method `step` to update the game at the tick rate of the game, and composes and displays a frame at the same
+ * rate, up to `MAX_FRAME_RATE` frames per second. Between deadlines set by a `FrameScheduler`, the game sleeps in the
+ * input source, so that input is read as soon as it arrives. Ticks missed while the process was descheduled are caught
+ * up, up to `MAX_CATCH_UP_TIME` milliseconds of them at a time. The schedule is restarted after the exit menu, so that
+ * time spent paused is not caught up.
+ *
+ * Headless games are not paced: ticks are run back to back, with a frame displayed as often in ticks as it would be
+ * displayed were the game paced.
+ *
+ * If the game is timed, composing and displaying each frame are timed as phases, as is how late the game woke after
+ * each deadline, and the deadlines missed and ticks dropped by the scheduler are added to the timings as they happen.
+ *
+ * If the game is being recorded, the recording is saved once the game has finished.
  */
 void Pong::runGameLoop() {
-    auto lastTickTime = timer::now();  // gets the current game start time in milliseconds.
+    int frameRate = std::min(config.tickRate, MAX_FRAME_RATE);
+    if (config.headless) {
+        int ticksPerFrame = config.tickRate / frameRate;
+        while (!gameFinished) {
+            if (gamePaused) {
+                exitMenu();
+                continue;
+            }
+            step();
+            if (tickCount % ticksPerFrame == 0) {
+                drawFrame();
+            }
+        }
+        finishRecording();
+        return;
+    }
+
+    FrameScheduler scheduler(std::chrono::nanoseconds(1000000000 / config.tickRate),
+                             std::chrono::nanoseconds(1000000000 / frameRate),
+                             std::max(1, MAX_CATCH_UP_TIME * config.tickRate / 1000));
 
     // While the game loop is active...
     while (!gameFinished) {
         if (gamePaused) {
             exitMenu();
-        } else {
-            auto currentTime = timer::now();  // gets the current time in nanoseconds.
-            if ((currentTime - lastTickTime) > std::literals::chrono_literals::operator ""ms(TICK_LENGTH)) {
-                lastTickTime = timer::now();
-                tick();  // runs a tick.
-                tickCount++;
+            scheduler.reset();
+            continue;
+        }
+        FrameScheduler::timer::time_point deadline = scheduler.getNextDeadline();
+        input->waitUntil(deadline);
+        long overruns = scheduler.getOverrunCount();
+        long droppedTicks = scheduler.getDroppedTickCount();
+        scheduler.update();
+        if (stats != nullptr) {
+            FrameScheduler::timer::time_point now = FrameScheduler::timer::now();
+            if (now >= deadline) {
+                stats->record(Phase::LATENESS, now - deadline);  // woken early by input otherwise.
             }
+            stats->addMissedDeadlines(scheduler.getOverrunCount() - overruns,
+                                      scheduler.getDroppedTickCount() - droppedTicks);
+        }
+        while (!gameFinished && !gamePaused && scheduler.tickDue()) {
+            step();
+        }
+        if (!gameFinished && scheduler.frameDue()) {
+            drawFrame();
+        }
+    }
+    finishRecording();
+}
+
+/**
+ * @brief Runs a single tick of the game.
+ *
+ * The game is finished once the tick limit of the configuration, if any, is reached. The tick is traced as a span.
+ */
+void Pong::step() {
+    {
+        TraceSpan span("Pong::tick", "game", "tick", tickCount);
+        tick();  // runs a tick.
+    }
+    tickCount++;
+    if (config.maxTicks != 0 && tickCount >= config.maxTicks) {
+        gameFinished = true;
+    }
+}
+
+/**
+ * @brief Starts recording the game, so that it can be replayed exactly.
+ *
+ * The input of the game is read through a `RecordingInputSource` from now on, and the recording is saved to the
+ * provided file, along with the settings of the game, once the game loop finishes. Recording should be started before
+ * the first tick.
+ *
+ * @param path the path of the file the recording is saved to
+ */
+void Pong::startRecording(const std::string &path) {
+    recorder = std::make_unique<RecordingInputSource>(input);
+    input = recorder.get();
+    recordingPath = path;
+}
+
+/**
+ * @brief Saves the recording of the game, if it is being recorded.
+ *
+ * The number of ticks played and the hash of the final state are saved with the recording, so that a replay can be
+ * checked against them. The user is told if the recording could not be saved.
+ */
+void Pong::finishRecording() {
+    if (recorder == nullptr) {
+        return;
+    }
+    PongReplay replay;
+    replay.width = renderer->getWidth();
+    replay.height = renderer->getHeight();
+    replay.config = config;
+    replay.inputs = recorder->getInputs();
+    replay.tickCount = (std::uint32_t)tickCount;
+    replay.stateHash = getStateHash();
+    if (!replay.save(recordingPath)) {
+        renderer->displayMessage("Unable to save the recording to " + recordingPath, true);
+        if (!config.headless) {
+            input->waitForKey();
+        }
+    }
+}
+
+/**
+ * @brief Gets a hash of the state of the game: the tick, the scores and the position and velocity of every entity.
+ *
+ * Two games which have played the same ticks with the same input have equal hashes, so the hash of a replay can be
+ * compared with that of the recorded game to check that the replay was exact.
+ *
+ * @return the 64 bit FNV-1a hash of the state
+ */
+std::uint64_t Pong::getStateHash() const {
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    auto mix = [&hash](const void *data, size_t size) {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * FNV_PRIME;
+        }
+    };
+    mix(&tickCount, sizeof(tickCount));
+    mix(scores, sizeof(scores));
+    for (EntityHandle handle = 0; handle < registry.capacity(); handle++) {
+        if (registry.isAlive(handle)) {
+            float state[4] = {registry.getX(handle), registry.getY(handle), registry.getXVelocity(handle),
+                              registry.getYVelocity(handle)};
+            mix(state, sizeof(state));
         }
     }
+    return hash;
+}
+
+/**
+ * @brief Getter for the score of a player.
+ *
+ * @param player the player, 0 for the left player or 1 for the right player
+ * @return the score of the player
+ */
+int Pong::getScore(int player) const {
+    return scores[player];
+}
+
+/**
+ * @brief Getter for the time played, which is the number of ticks run over the tick rate.
+ *
+ * @return the time played, in seconds
+ */
+double Pong::getElapsedSeconds() const {
+    return (double)tickCount / config.tickRate;
 }
 
 /**
@@ -370,10 +674,12 @@ void Pong::runGameLoop() {
 void Pong::score(int player) {
     scores[player]++;
     if (maxScore != 0 && scores[player] == maxScore) {
-        registerHighScore(player + 1);
-        displayMessage("Press any key to return to the main menu", 0);
-        renderer->draw(gameBoard);
-        while (InputWatcher::getInstance().getKeyPress() == '\0');
+        if (!config.headless) {
+            registerHighScore(player + 1);
+            displayMessage("Press any key to return to the main menu", 0);
+            renderer->draw(composeFrame());
+            input->waitForKey();
+        }
         gameFinished = true;
     }
 }
@@ -9,41 +9,90 @@
 #ifndef PONG_H
 #define PONG_H
 
+#include <cstdint>
+#include <memory>
 #include "../Game.h"
+#include "../InputEvent.h"
+#include "../RecordingInputSource.h"
+#include "PongConfig.h"
 
 /**
  * @brief Declaration for concrete `Pong` class.
  *
  * Class provides an implementation of abstract superclass `Game` to be played. It provides appropriate constructor,
  * destructor and gameplay method implementations.
+ *
+ * Entities are simulated at float positions, and are drawn onto a copy of the game board, rounded to the nearest cell,
+ * only when a frame is displayed. The game board itself holds only text, so a tick never draws.
+ *
+ * The game is deterministic: its state after each tick depends only on its settings and the input drained in each tick,
+ * never on the clock. A game can therefore be recorded as its settings and input, and replayed exactly, and at any
+ * speed, as a headless game.
  */
 class Pong : public Game {
 private:
-    using timer = std::chrono::steady_clock;
-    int AICount;
-    int difficulty[2];
+    PongConfig config;
+    FrameBuffer frame;
     int scores[2];
+    std::vector<InputEvent> keyPresses;
+    EntityHandle ball;
+    EntityHandle leftPaddle;
+    EntityHandle rightPaddle;
+    std::unique_ptr<RecordingInputSource> recorder;
+    std::string recordingPath;
+    std::uint64_t serveState;
 
     void tick() override;
 
-    void displayGameTime();
+    void createEntities();
 
-    void updateBoard(std::vector<std::vector<std::pair<std::string, Colour>>> *gameBoard, Entity *entity, int width, int height, const std::pair<std::string, Colour> &newValue);
+    void checkTimeLimit();
+
+    void displayGameTime();
 
     void displayScore();
 
     void clearMessage(int length, int displacement = 0);
 
-    void checkBallScored(Entity *ball);
+    void movePaddle(EntityHandle paddle, int direction);
+
+    void checkBallScored();
 
     void score(int player);
 
+    void serve();
+
+    std::uint64_t nextRandom();
+
+    void finishRecording();
+
 public:
-    explicit Pong(Renderer *renderer, int maxScore, int maxTime);
+    Pong(Renderer *renderer, int maxScore, int maxTime, PaddleAI AIMode = PaddleAI::TRACKING);
+
+    Pong(Renderer *renderer, const PongConfig &config, InputSource *input);
 
     ~Pong() override;
 
     void runGameLoop() override;
+
+    const FrameBuffer &composeFrame() override;
+
+    void step();
+
+    void restart();
+
+    void startRecording(const std::string &path);
+
+    int getScore(int player) const;
+
+    double getElapsedSeconds() const;
+
+    std::uint64_t getStateHash() const;
+
+    static void updateBoard(FrameBuffer *gameBoard, Entity *entity, int width, int height, const Cell &newValue);
+
+    static PongConfig promptForConfig(Renderer *renderer, int maxScore, int maxTime,
+                                      PaddleAI AIMode = PaddleAI::TRACKING);
 };
 
 #endif
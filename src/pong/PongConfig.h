@@ -0,0 +1,63 @@
+/**
+ * File contains declaration for `PongConfig` structure.
+ *
+ * @file PongConfig.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef PONG_CONFIG_H
+#define PONG_CONFIG_H
+
+#include <cstdint>
+
+#define BASE_TICK_RATE 20  // ticks per second at which the game was tuned, at which entities move a cell per tick.
+#define MIN_TICK_RATE 20  // lowest tick rate, at which a paddle moves at most a cell per tick.
+#define MAX_TICK_RATE 1000
+#define MIN_BALL_SPEED 1  // slowest ball speed, in cells per second.
+#define MAX_BALL_SPEED 200
+
+/**
+ * @brief How AI paddles choose where to move.
+ *
+ * A tracking AI moves towards the ball's current row, reconsidering every few ticks. A predictive AI works out where
+ * the ball will reach its column, bouncing off the walls, whenever the ball changes course, and moves to meet it.
+ */
+enum class PaddleAI : std::uint8_t {
+    TRACKING,
+    PREDICTIVE
+};
+
+/**
+ * @brief Declaration of `PongConfig` structure.
+ *
+ * Holds every setting a game of `Pong` needs, so that a game can be constructed without prompting the user.
+ *
+ * The number of AI players is 0 for human versus human, 1 for human versus AI and 2 for AI versus AI. Difficulties
+ * range from 0 (easy) to 3 (extreme), and are -1 for human players. Limits of zero are unlimited.
+ *
+ * A headless game shows no instructions, waits for no key presses, registers no high scores and is not paced by the
+ * clock, so it runs as fast as it can be stepped. A headless game ends after `maxTicks` ticks, if non-zero, even if
+ * neither the score nor the time limit has been reached.
+ *
+ * The game is simulated at `tickRate` ticks per second. The ball is served at `ballSpeed` cells per second, and its
+ * speed is increased by `speedRamp` percent each time a paddle returns it, up to three times its serving speed.
+ *
+ * A seed of zero serves the ball the same way every point. Any other seed serves the ball in a direction drawn from a
+ * generator seeded by it, so that games with different seeds play out differently while each remains deterministic.
+ */
+struct PongConfig {
+    int AICount = 0;
+    int difficulty[2] = {-1, -1};
+    int maxScore = 5;
+    int maxTime = 2;  // minutes.
+    bool headless = false;
+    long maxTicks = 0;
+    std::uint32_t seed = 0;
+    PaddleAI AIMode = PaddleAI::TRACKING;
+    int tickRate = BASE_TICK_RATE;
+    int ballSpeed = BASE_TICK_RATE;
+    int speedRamp = 0;
+};
+
+#endif
@@ -0,0 +1,130 @@
+/**
+ * File contains definition of `PongReplay` structure.
+ *
+ * @file PongReplay.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <fstream>
+#include "PongReplay.h"
+
+static_assert(sizeof(RecordedInput) == 8, "recorded input events are stored as 8 bytes");
+
+/**
+ * @brief Static helper function writes a value to a stream as its raw bytes.
+ *
+ * @tparam T the type of the value
+ * @param stream the stream to write to
+ * @param value the value
+ */
+template<typename T>
+static void writeValue(std::ostream &stream, const T &value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Static helper function reads a value from a stream as its raw bytes.
+ *
+ * @tparam T the type of the value
+ * @param stream the stream to read from
+ * @param value set to the value read
+ */
+template<typename T>
+static void readValue(std::istream &stream, T &value) {
+    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Writes the replay to a file, replacing it if it exists.
+ *
+ * @param path the path of the file
+ * @return true if the replay was written, false if an error occurred
+ */
+bool PongReplay::save(const std::string &path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    writeValue(file, (std::uint32_t)REPLAY_MAGIC);
+    writeValue(file, (std::uint32_t)REPLAY_VERSION);
+    writeValue(file, width);
+    writeValue(file, height);
+    writeValue(file, (std::int32_t)config.AICount);
+    writeValue(file, (std::int32_t)config.difficulty[0]);
+    writeValue(file, (std::int32_t)config.difficulty[1]);
+    writeValue(file, (std::int32_t)config.maxScore);
+    writeValue(file, (std::int32_t)config.maxTime);
+    writeValue(file, config.seed);
+    writeValue(file, config.AIMode);
+    writeValue(file, (std::int32_t)config.tickRate);
+    writeValue(file, (std::int32_t)config.ballSpeed);
+    writeValue(file, (std::int32_t)config.speedRamp);
+    writeValue(file, tickCount);
+    writeValue(file, stateHash);
+    writeValue(file, (std::uint32_t)inputs.size());
+    file.write(reinterpret_cast<const char *>(inputs.data()), (std::streamsize)(inputs.size() * sizeof(RecordedInput)));
+    return file.good();
+}
+
+/**
+ * @brief Reads a replay from a file.
+ *
+ * The configuration read is that of the recorded game, so it is not headless and has no tick limit.
+ *
+ * @param path the path of the file
+ * @return true if the replay was read, false if the file could not be read, is truncated or is not a replay of this
+ * version
+ */
+bool PongReplay::load(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    readValue(file, magic);
+    readValue(file, version);
+    if (magic != REPLAY_MAGIC || version != REPLAY_VERSION) {
+        return false;
+    }
+    std::int32_t fields[5];
+    readValue(file, width);
+    readValue(file, height);
+    readValue(file, fields);
+    std::uint32_t seed = 0;
+    readValue(file, seed);
+    PaddleAI AIMode = PaddleAI::TRACKING;
+    readValue(file, AIMode);
+    std::int32_t speeds[3];
+    readValue(file, speeds);
+    readValue(file, tickCount);
+    readValue(file, stateHash);
+    std::uint32_t inputCount = 0;
+    readValue(file, inputCount);
+    if (!file.good()) {
+        return false;
+    }
+    // The count is checked against the size of the file before the inputs are allocated, in case it is corrupt.
+    std::streampos start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - start;
+    file.seekg(start);
+    if (remaining != (std::streamoff)(inputCount * sizeof(RecordedInput))) {
+        return false;
+    }
+    config = PongConfig();
+    config.AICount = fields[0];
+    config.difficulty[0] = fields[1];
+    config.difficulty[1] = fields[2];
+    config.maxScore = fields[3];
+    config.maxTime = fields[4];
+    config.seed = seed;
+    config.AIMode = AIMode;
+    config.tickRate = speeds[0];
+    config.ballSpeed = speeds[1];
+    config.speedRamp = speeds[2];
+    inputs.resize(inputCount);
+    file.read(reinterpret_cast<char *>(inputs.data()), (std::streamsize)(inputCount * sizeof(RecordedInput)));
+    return file.good();
+}
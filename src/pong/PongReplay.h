@@ -0,0 +1,44 @@
+/**
+ * File contains declaration for `PongReplay` structure.
+ *
+ * @file PongReplay.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef PONG_REPLAY_H
+#define PONG_REPLAY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../RecordingInputSource.h"
+#include "PongConfig.h"
+
+#define REPLAY_MAGIC 0x4c505250u  // "PRPL" in little-endian byte order, identifying a replay file.
+#define REPLAY_VERSION 4  // version of the replay file format, incremented whenever it changes.
+
+/**
+ * @brief Declaration of `PongReplay` structure.
+ *
+ * Holds everything needed to replay a game of `Pong` exactly: the board size and settings it was played with and the
+ * input it was given, along with the number of ticks it lasted and a hash of its final state, against which a replay
+ * is checked.
+ *
+ * Replays are stored as a compact binary file: a header of fixed size fields followed by 8 bytes per input event. The
+ * fields are stored in the byte order of the machine, which is little-endian on every supported platform.
+ */
+struct PongReplay {
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    PongConfig config;
+    std::vector<RecordedInput> inputs;
+    std::uint32_t tickCount = 0;
+    std::uint64_t stateHash = 0;
+
+    bool save(const std::string &path) const;
+
+    bool load(const std::string &path);
+};
+
+#endif
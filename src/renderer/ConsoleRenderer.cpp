@@ -7,31 +7,46 @@
  */
 
 #include <iostream>
+#include <cerrno>
+#include <unistd.h>
 #include "ConsoleRenderer.h"
+#include "../TraceWriter.h"
 
-#define CONSOLE_RESET "\u001b[0;0H" << "\u001b[2J" << "\033[H\033[2J\033[3J"  // ANSI control character to reset cursor.
+#define CONSOLE_RESET "\u001b[0;0H\u001b[2J\033[H\033[2J\033[3J"  // ANSI control character to reset cursor.
+#define COLOUR_RESET "\u001b[0m"  // ANSI control sequence to restore the default terminal colour.
+#define BORDER_OFFSET 2  // 1-based terminal position of the first matrix row/column, inside the border.
+#define MAX_RUN_GAP 4  // unchanged cells shorter than a cursor jump are re-emitted to coalesce adjacent dirty runs.
+#define BYTES_PER_CELL 12  // generous estimate of the bytes needed per cell (colour sequence and UTF-8 glyph).
 
 /**
  * @brief Constructor for when no matrix is provided.
  *
- * The constructor for abstract superclass `Renderer` is called with the provided parameters. There is no additional
- * implementation.
+ * The constructor for abstract superclass `Renderer` is called with the provided parameters. The frame buffer is
+ * preallocated to hold a full redraw of the matrix. Frames are written to the provided file descriptor, while menus and
+ * messages are always written to standard output.
  * 
  * @param width the width of the matrix
  * @param height the height of the matrix
+ * @param outputFd the file descriptor frames are written to
  */
-ConsoleRenderer::ConsoleRenderer(int width, int height) : Renderer(width, height) {}
+ConsoleRenderer::ConsoleRenderer(int width, int height, int outputFd) : Renderer(width, height) {
+    this->outputFd = outputFd;
+    frame.reserve((width + 2) * (height + 2) * BYTES_PER_CELL);
+}
 
 /**
  * @brief Constructor for when a pre-defined matrix is provided to display.
  * 
- * The constructor for abstract superclass `Renderer` is called with the provided parameters. There is no additional
- * implementation.
+ * The constructor for abstract superclass `Renderer` is called with the provided parameters. The frame buffer is
+ * preallocated to hold a full redraw of the matrix.
  *
- * @param matrix the 2D vector to be used to construct renderer (and to be displayed)
+ * @param matrix the frame buffer to be used to construct renderer (and to be displayed)
  */
-ConsoleRenderer::ConsoleRenderer(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) :
-        Renderer(matrix) {}
+ConsoleRenderer::ConsoleRenderer(const FrameBuffer &matrix) :
+        Renderer(matrix) {
+    this->outputFd = STDOUT_FILENO;
+    frame.reserve((width + 2) * (height + 2) * BYTES_PER_CELL);
+}
 
 /**
  * @brief Default destructor.
@@ -41,49 +56,58 @@ ConsoleRenderer::ConsoleRenderer(const std::vector<std::vector<std::pair<std::st
 ConsoleRenderer::~ConsoleRenderer() = default;
 
 /**
- * @brief Writes the textual representation of the provided matrix to the command line, given a 2D vector.
+ * @brief Writes the textual representation of the provided matrix to the command line, given a frame buffer.
  * 
- * The string 2D vector is traversed and value within the array are printed. Pairs are used so that the colour of the
- * character on the board can be displayed. A border is drawn around the game matrix using Unicode box drawing
- * characters.
+ * If the terminal already shows a matrix of the same dimensions, only the cells that differ from the previously drawn
+ * matrix are written, using cursor-positioning escape sequences. Adjacent dirty runs separated by a short gap of
+ * unchanged cells are coalesced into a single run. Otherwise, the terminal is cleared and the whole matrix is written,
+ * with a border drawn around it using Unicode box drawing characters.
+ *
+ * The frame is assembled in a reusable buffer and written to the output file descriptor with a single system call. The
+ * draw is traced as a span.
  *
  * @param matrix the matrix to be drawn
  */
-void ConsoleRenderer::draw(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) {
-    std::cout << CONSOLE_RESET;
-    drawHorizontal(true);
-    for (int y = 0; y < height; y++) {
-        std::cout << "│";
-        for (int x = 0; x < width; x++) {
-            printWithColour(matrix[y][x]);
-        }
-        std::cout << "│" << std::endl;
+void ConsoleRenderer::draw(const FrameBuffer &matrix) {
+    TraceSpan span("ConsoleRenderer::draw", "render");
+    frame.clear();
+    currentColour = Colour::TERMINAL_DEFAULT;
+    if (redrawRequired || previousMatrix.getWidth() != matrix.getWidth() ||
+        previousMatrix.getHeight() != matrix.getHeight()) {
+        drawFull(matrix);
+    } else {
+        drawChanges(matrix);
     }
-    drawHorizontal(false);
+    if (currentColour != Colour::TERMINAL_DEFAULT) {
+        frame.append(COLOUR_RESET);
+    }
+    writeFrame();
     previousMatrix = matrix;
+    redrawRequired = false;
 }
 
 /**
  * @brief Updates the matrix displayed with the change provided at given coordinates.
  * 
  * Makes a change to the previously displayed matrix array and writes the textual representation of this new matrix to
- * the command line, given the position and new pair for the change to be made to the 2D vector.
+ * the command line, given the position and new cell for the change to be made to the frame buffer.
  *
  * @param x the x-coordinate of the position in the matrix to be updated
  * @param y the y-coordinate of the position in the matrix to be updated
- * @param state the new pair of character and colour for the position to be updated
+ * @param state the new cell of character and colour for the position to be updated
  * @throws runtime_error if there is no matrix to update (if the object is instantiated with no provided matrix)
  * @throws runtime_error if the provided index (x, y) is out of bounds
  */
-void ConsoleRenderer::draw(int x, int y, std::pair<std::string, Colour> state) {
+void ConsoleRenderer::draw(int x, int y, Cell state) {
     if (previousMatrix.empty()) {
         throw std::runtime_error("no matrix exists to update");
     }
     if (x < 0 || x >= width || y < 0 || y >= height) {
         throw std::runtime_error("index out of bounds");
     }
-    previousMatrix[y][x] = state;
-    draw(previousMatrix);
+    FrameBuffer matrix = previousMatrix;
+    matrix.at(x, y) = state;
+    draw(matrix);
 }
 
 /**
@@ -99,6 +123,7 @@ void ConsoleRenderer::draw(int x, int y, std::pair<std::string, Colour> state) {
  */
 void ConsoleRenderer::displayMenu(std::string menuText, std::vector<std::string> options) {
     std::cout << CONSOLE_RESET;
+    redrawRequired = true;
     std::cout << menuText << std::endl << std::endl;
     for (int i = 0; i < options.size(); i++) {
         if (!options[i].empty()) {
@@ -125,63 +150,203 @@ void ConsoleRenderer::displayMessage(std::string message, bool reset) {
         std::cout << CONSOLE_RESET;
     }
     std::cout << message << std::endl;
+    redrawRequired = true;
+}
+
+/**
+ * @brief Appends a terminal clear followed by the whole matrix surrounded by a border to the frame buffer.
+ *
+ * @param matrix the matrix to be drawn
+ */
+void ConsoleRenderer::drawFull(const FrameBuffer &matrix) {
+    frame.append(CONSOLE_RESET);
+    drawHorizontal(true);
+    for (int y = 0; y < height; y++) {
+        frame.append("│");
+        for (int x = 0; x < width; x++) {
+            appendWithColour(matrix.at(x, y));
+        }
+        appendColour(Colour::TERMINAL_DEFAULT);
+        frame.append("│\n");
+    }
+    drawHorizontal(false);
+}
+
+/**
+ * @brief Appends only the cells of the matrix which differ from the previously drawn matrix to the frame buffer.
+ *
+ * Each row is scanned for runs of changed cells. A run is extended across gaps of at most `MAX_RUN_GAP` unchanged
+ * cells, as re-emitting these is cheaper than another cursor jump. The cursor is moved to the start of each run before
+ * it is written, and is left below the border once all runs have been written.
+ *
+ * @param matrix the matrix to be drawn
+ */
+void ConsoleRenderer::drawChanges(const FrameBuffer &matrix) {
+    bool changed = false;
+    for (int y = 0; y < height; y++) {
+        const Cell *row = matrix.row(y);
+        const Cell *previousRow = previousMatrix.row(y);
+        int x = 0;
+        while (x < width) {
+            if (row[x] == previousRow[x]) {
+                x++;
+                continue;
+            }
+            int start = x;
+            int end = x + 1;  // one past the last changed cell of the run.
+            for (int next = end; next < width && next - end <= MAX_RUN_GAP; next++) {
+                if (row[next] != previousRow[next]) {
+                    end = next + 1;
+                }
+            }
+            appendCursorMove(y + BORDER_OFFSET, start + BORDER_OFFSET);
+            for (x = start; x < end; x++) {
+                appendWithColour(row[x]);
+            }
+            changed = true;
+        }
+    }
+    if (changed) {
+        appendCursorMove(height + BORDER_OFFSET + 1, 1);
+    }
 }
 
 /**
- * @brief Writes top and bottom of box surrounding matrix.
+ * @brief Appends the top or bottom of the box surrounding the matrix to the frame buffer.
  *
  * Unicode box drawing characters are used to create a border around the game matrix.
  *
  * @param top true if the top of the box is being written, false if the bottom of the box is being written
  */
 void ConsoleRenderer::drawHorizontal(bool top) {
-    std::cout << (top ? "┌" : "└");
+    frame.append(top ? "┌" : "└");
     for (int i = 0; i < width; i++) {
-        std::cout << "─";
+        frame.append("─");
     }
-    std::cout << (top ? "┐" : "┘") << std::endl;
+    frame.append(top ? "┐\n" : "┘\n");
 }
 
 /**
- * @brief Prints the character of the provided pair to the terminal in the provided colour.
+ * @brief Appends the character of the provided cell to the frame buffer in the cell's colour.
  *
- * The basic 8 ANSI terminal colours are supported here, with a default value of black if the colour is unsupported.
+ * A colour escape sequence is only appended when the colour differs from that of the previously appended cell.
  *
- * @param pair the character `Colour` pair to be printed
+ * @param cell the cell to be appended
  */
-void ConsoleRenderer::printWithColour(const std::pair<std::string, Colour> &pair) {
-    if (pair.second == Colour::TERMINAL_DEFAULT) {
-        std::cout << pair.first;
+void ConsoleRenderer::appendWithColour(const Cell &cell) {
+    appendColour(cell.colour);
+    if (cell.glyph < ASCII_GLYPHS) {
+        frame.push_back((char)cell.glyph);
     } else {
-        std::cout << "\u001b[";
-        switch (pair.second) {
-            case Colour::BLACK:
-                std::cout << 30;
-                break;
-            case Colour::RED:
-                std::cout << 31;
-                break;
-            case Colour::GREEN:
-                std::cout << 32;
-                break;
-            case Colour::YELLOW:
-                std::cout << 33;
-                break;
-            case Colour::BLUE:
-                std::cout << 34;
-                break;
-            case Colour::MAGENTA:
-                std::cout << 35;
-                break;
-            case Colour::CYAN:
-                std::cout << 36;
-                break;
-            case Colour::WHITE:
-                std::cout << 37;
-                break;
-            default:
-                std::cout << 30;
+        frame.append(GlyphTable::getInstance().lookup(cell.glyph));
+    }
+}
+
+/**
+ * @brief Appends the escape sequence selecting the provided colour to the frame buffer, if it is not already selected.
+ *
+ * The basic 8 ANSI terminal colours are supported here, with a default value of black if the colour is unsupported.
+ *
+ * @param colour the colour subsequent characters should be written in
+ */
+void ConsoleRenderer::appendColour(Colour colour) {
+    if (colour == currentColour) {
+        return;
+    }
+    currentColour = colour;
+    switch (colour) {
+        case Colour::TERMINAL_DEFAULT:
+            frame.append(COLOUR_RESET);
+            return;
+        case Colour::BLACK:
+            frame.append("\u001b[30m");
+            return;
+        case Colour::RED:
+            frame.append("\u001b[31m");
+            return;
+        case Colour::GREEN:
+            frame.append("\u001b[32m");
+            return;
+        case Colour::YELLOW:
+            frame.append("\u001b[33m");
+            return;
+        case Colour::BLUE:
+            frame.append("\u001b[34m");
+            return;
+        case Colour::MAGENTA:
+            frame.append("\u001b[35m");
+            return;
+        case Colour::CYAN:
+            frame.append("\u001b[36m");
+            return;
+        case Colour::WHITE:
+            frame.append("\u001b[37m");
+            return;
+        default:
+            frame.append("\u001b[30m");
+    }
+}
+
+/**
+ * @brief Appends the escape sequence moving the cursor to the provided 1-based terminal position to the frame buffer.
+ *
+ * @param row the terminal row to move to
+ * @param column the terminal column to move to
+ */
+void ConsoleRenderer::appendCursorMove(int row, int column) {
+    frame.append("\u001b[");
+    appendNumber(row);
+    frame.push_back(';');
+    appendNumber(column);
+    frame.push_back('H');
+}
+
+/**
+ * @brief Appends the decimal representation of a non-negative number to the frame buffer without allocating.
+ *
+ * @param number the number to be appended
+ */
+void ConsoleRenderer::appendNumber(int number) {
+    char digits[10];
+    int count = 0;
+    do {
+        digits[count++] = (char)('0' + number % 10);
+        number /= 10;
+    } while (number > 0);
+    while (count > 0) {
+        frame.push_back(digits[--count]);
+    }
+}
+
+/**
+ * @brief Writes the assembled frame buffer to the output file descriptor.
+ *
+ * Any output still buffered by `std::cout` is flushed first so that output order is preserved. The frame is then
+ * written with a single call to `write`, which is only repeated if the write is interrupted or partial.
+ */
+void ConsoleRenderer::writeFrame() {
+    std::cout << std::flush;
+    const char *data = frame.data();
+    size_t remaining = frame.size();
+    while (remaining > 0) {
+        ssize_t written = write(outputFd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
         }
-        std::cout << "m" << pair.first << "\u001b[0m";
+        data += written;
+        remaining -= written;
+        bytesWritten += written;
     }
 }
+
+/**
+ * @brief Getter for the total number of bytes of frames written.
+ *
+ * @return the number of bytes written
+ */
+long ConsoleRenderer::getBytesWritten() const {
+    return bytesWritten;
+}
@@ -9,6 +9,7 @@
 #ifndef CONSOLE_RENDERER_H
 #define CONSOLE_RENDERER_H
 
+#include <unistd.h>
 #include "Renderer.h"
 
 /**
@@ -18,24 +19,45 @@
  * provides appropriate constructor, destructor and draw method implementations.
  */
 class ConsoleRenderer : public Renderer {
+private:
+    bool redrawRequired = true;
+    int outputFd;
+    long bytesWritten = 0;
+    std::string frame;
+    Colour currentColour = Colour::TERMINAL_DEFAULT;
+
+    void drawFull(const FrameBuffer &matrix);
+
+    void drawChanges(const FrameBuffer &matrix);
+
+    void drawHorizontal(bool top);
+
+    void appendWithColour(const Cell &cell);
+
+    void appendColour(Colour colour);
+
+    void appendCursorMove(int row, int column);
+
+    void appendNumber(int number);
+
+    void writeFrame();
+
 public:
-    ConsoleRenderer(int width, int height);
+    ConsoleRenderer(int width, int height, int outputFd = STDOUT_FILENO);
 
-    explicit ConsoleRenderer(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix);
+    explicit ConsoleRenderer(const FrameBuffer &matrix);
 
     ~ConsoleRenderer() override;
 
-    void draw(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) override;
+    void draw(const FrameBuffer &matrix) override;
 
-    void draw(int x, int y, std::pair<std::string, Colour> state) override;
+    void draw(int x, int y, Cell state) override;
 
     void displayMenu(std::string menuText, std::vector<std::string> options) override;
 
     void displayMessage(std::string message, bool reset) override;
 
-    void drawHorizontal(bool top);
-
-    static void printWithColour(const std::pair<std::string, Colour> &);
+    long getBytesWritten() const;
 };
 
 #endif
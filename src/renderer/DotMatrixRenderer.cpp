@@ -1,96 +1,279 @@
 /**
  * File contains concrete definition of `DotMatrixRenderer` subclass.
- * 
+ *
  * @file DotMatrixRenderer.cpp
  * @co_author https://github.com/Jon-AL
  * @date 05/11/21
  */
 
-#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <linux/fb.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "DotMatrixRenderer.h"
 
+#define FRAMEBUFFER_PREFIX "/dev/fb"  // prefix of framebuffer device paths, which are never created.
+
+/**
+ * @brief The red, green and blue intensity of each colour, in the order of the `Colour` enumeration.
+ *
+ * The terminal default colour is shown as white.
+ */
+static const unsigned char COLOUR_RGB[COLOUR_COUNT][3] = {
+        {0,   0,   0},
+        {255, 0,   0},
+        {0,   255, 0},
+        {255, 255, 0},
+        {0,   0,   255},
+        {255, 0,   255},
+        {0,   255, 255},
+        {255, 255, 255},
+        {255, 255, 255}
+};
+
+/**
+ * @brief Static helper function packs an 8 bit colour channel into its bits of a pixel.
+ *
+ * @param value the intensity of the channel
+ * @param bitfield the position and width of the channel within a pixel
+ * @return the channel shifted into place
+ */
+static std::uint32_t packChannel(unsigned char value, const fb_bitfield &bitfield) {
+    if (bitfield.length == 0) {
+        return 0;
+    }
+    std::uint32_t scaled = bitfield.length >= 8 ? value : value >> (8 - bitfield.length);
+    return scaled << bitfield.offset;
+}
+
 /**
  * @brief Constructor for when no matrix is provided.
- * 
- * The constructor for abstract superclass `Renderer` is called with the provided parameters. There is no additional
- * implementation.
+ *
+ * The constructor for abstract superclass `Renderer` is called with the provided parameters, and the pixel sink is
+ * mapped into memory and cleared.
  *
  * @param width the width of the matrix
  * @param height the height of the matrix
+ * @param device the path of the framebuffer device or file the matrix is written to
+ * @throws runtime_error if the device cannot be opened or mapped, or has an unsupported pixel format
  */
-DotMatrixRenderer::DotMatrixRenderer(int width, int height) : Renderer(width, height) {}
+DotMatrixRenderer::DotMatrixRenderer(int width, int height, const std::string &device)
+        : Renderer(width, height), console(width, height) {
+    openDevice(device);
+    clearPixels();
+}
 
 /**
  * @brief Constructor for when a pre-defined matrix is provided to display.
  *
- * The constructor for abstract superclass `Renderer` is called with the provided parameters. There is no additional
- * implementation.
- * 
- * @param matrix the 2D vector to be used to construct renderer (and to be displayed)
+ * The constructor for abstract superclass `Renderer` is called with the provided parameters, the pixel sink is mapped
+ * into memory and the matrix is drawn.
+ *
+ * @param matrix the frame buffer to be used to construct renderer (and to be displayed)
+ * @param device the path of the framebuffer device or file the matrix is written to
+ * @throws runtime_error if the device cannot be opened or mapped, or has an unsupported pixel format
  */
-DotMatrixRenderer::DotMatrixRenderer(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix)
-        : Renderer(matrix) {}
+DotMatrixRenderer::DotMatrixRenderer(const FrameBuffer &matrix, const std::string &device)
+        : Renderer(matrix), console(matrix.getWidth(), matrix.getHeight()) {
+    openDevice(device);
+    clearPixels();
+    draw(matrix);
+}
 
 /**
  * @brief Default destructor.
- * 
- * No memory is allocated.
+ *
+ * The matrix is cleared, so that no LEDs are left lit, and the pixel sink is unmapped and closed.
  */
-DotMatrixRenderer::~DotMatrixRenderer() = default;
+DotMatrixRenderer::~DotMatrixRenderer() {
+    clearPixels();
+    munmap(mapping, mappingSize);
+    close(fd);
+}
 
 /**
- * @brief Stub; method not yet implemented.
- * 
- * Writes the textual representation of the provided matrix to the command line, given a 2D vector.
+ * @brief Opens the pixel sink and maps it into memory.
+ *
+ * The geometry and pixel format of a framebuffer device are read from the device, and only its visible area is
+ * written to. Any other file is sized to hold the matrix as 32 bit XRGB pixels. Framebuffer devices are never created,
+ * so that a missing device is reported rather than replaced by a file.
+ *
+ * @param device the path of the framebuffer device or file
+ * @throws runtime_error if the device cannot be opened or mapped, or has an unsupported pixel format
+ */
+void DotMatrixRenderer::openDevice(const std::string &device) {
+    int flags = O_RDWR | O_CLOEXEC;
+    if (device.rfind(FRAMEBUFFER_PREFIX, 0) != 0) {
+        flags |= O_CREAT;
+    }
+    fd = open(device.c_str(), flags, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(device + ": " + std::strerror(errno));
+    }
+    auto fail = [this, &device](const std::string &reason) {
+        close(fd);
+        throw std::runtime_error(device + ": " + reason);
+    };
+    struct stat status{};
+    if (fstat(fd, &status) < 0) {
+        fail(std::strerror(errno));
+    }
+    fb_var_screeninfo variable{};
+    std::size_t offset = 0;
+    if (S_ISCHR(status.st_mode)) {
+        fb_fix_screeninfo fixed{};
+        if (ioctl(fd, FBIOGET_VSCREENINFO, &variable) < 0 || ioctl(fd, FBIOGET_FSCREENINFO, &fixed) < 0) {
+            fail(std::strerror(errno));
+        }
+        deviceWidth = (int)variable.xres;
+        deviceHeight = (int)variable.yres;
+        stride = (int)fixed.line_length;
+        mappingSize = fixed.smem_len;
+        offset = variable.yoffset * fixed.line_length + variable.xoffset * (variable.bits_per_pixel / 8);
+    } else {
+        deviceWidth = width;
+        deviceHeight = height;
+        stride = width * 4;
+        mappingSize = (std::size_t)stride * height;
+        variable.bits_per_pixel = 32;
+        variable.red = {16, 8, 0};
+        variable.green = {8, 8, 0};
+        variable.blue = {0, 8, 0};
+        if ((std::size_t)status.st_size < mappingSize && ftruncate(fd, (off_t)mappingSize) < 0) {
+            fail(std::strerror(errno));
+        }
+    }
+    if (variable.bits_per_pixel != 16 && variable.bits_per_pixel != 32) {
+        fail("unsupported pixel depth of " + std::to_string(variable.bits_per_pixel) + " bits");
+    }
+    bytesPerPixel = (int)variable.bits_per_pixel / 8;
+    for (int colour = 0; colour < COLOUR_COUNT; colour++) {
+        palette[colour] = packChannel(COLOUR_RGB[colour][0], variable.red) |
+                          packChannel(COLOUR_RGB[colour][1], variable.green) |
+                          packChannel(COLOUR_RGB[colour][2], variable.blue);
+    }
+    void *memory = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        fail(std::strerror(errno));
+    }
+    mapping = static_cast<unsigned char *>(memory);
+    pixels = mapping + offset;
+}
+
+/**
+ * @brief Writes every cell of the matrix which fits on the display into the mapped pixels.
+ *
+ * @tparam Pixel the unsigned integer type holding a single pixel
+ * @param matrix the matrix to be drawn
+ */
+template<typename Pixel>
+void DotMatrixRenderer::drawPixels(const FrameBuffer &matrix) {
+    int columns = std::min(matrix.getWidth(), deviceWidth);
+    int rows = std::min(matrix.getHeight(), deviceHeight);
+    Pixel unlit = (Pixel)palette[(int)Colour::BLACK];
+    for (int y = 0; y < rows; y++) {
+        const Cell *row = matrix.row(y);
+        auto *out = reinterpret_cast<Pixel *>(pixels + (std::size_t)y * stride);
+        for (int x = 0; x < columns; x++) {
+            out[x] = row[x].glyph == ' ' ? unlit : (Pixel)palette[(int)row[x].colour];
+        }
+    }
+}
+
+/**
+ * @brief Writes a single cell into the mapped pixels, if it fits on the display.
+ *
+ * @param x the x-coordinate of the cell
+ * @param y the y-coordinate of the cell
+ * @param cell the cell to be drawn
+ */
+void DotMatrixRenderer::writePixel(int x, int y, const Cell &cell) {
+    if (x >= deviceWidth || y >= deviceHeight) {
+        return;
+    }
+    std::uint32_t pixel = palette[cell.glyph == ' ' ? (int)Colour::BLACK : (int)cell.colour];
+    unsigned char *out = pixels + (std::size_t)y * stride + (std::size_t)x * bytesPerPixel;
+    if (bytesPerPixel == 4) {
+        *reinterpret_cast<std::uint32_t *>(out) = pixel;
+    } else {
+        *reinterpret_cast<std::uint16_t *>(out) = (std::uint16_t)pixel;
+    }
+}
+
+/**
+ * @brief Turns off every pixel of the display which the matrix covers.
+ */
+void DotMatrixRenderer::clearPixels() {
+    int columns = std::min(width, deviceWidth);
+    int rows = std::min(height, deviceHeight);
+    for (int y = 0; y < rows; y++) {
+        std::memset(pixels + (std::size_t)y * stride, 0, (std::size_t)columns * bytesPerPixel);
+    }
+}
+
+/**
+ * @brief Writes the provided matrix to the dot matrix display.
+ *
+ * Every cell is written straight into the mapped pixels, so a full refresh of the board costs a few microseconds and
+ * the previously drawn matrix does not need to be kept. Cells outside of the display are clipped.
  *
  * @param matrix the matrix to be drawn
  */
-void DotMatrixRenderer::draw(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) {
-    std::cerr << "No implementation provided for `DotMatrixRenderer::draw(const std::vector<std::vector<std::string>>)`"
-              << std::endl;
-    exit(0);
+void DotMatrixRenderer::draw(const FrameBuffer &matrix) {
+    if (bytesPerPixel == 4) {
+        drawPixels<std::uint32_t>(matrix);
+    } else {
+        drawPixels<std::uint16_t>(matrix);
+    }
 }
 
 /**
- * @brief Stub; method not yet implemented.
- * 
- * Makes a change to the previously displayed matrix array and writes the textual representation of this new matrix to
- * the command line, given the position and new pair of character and colour.
+ * @brief Updates a single cell of the matrix displayed.
  *
  * @param x the x-coordinate of the position in the matrix to be updated
  * @param y the y-coordinate of the position in the matrix to be updated
- * @param state the new pair of character and colour at the position to be updated
+ * @param state the new cell of character and colour at the position to be updated
+ * @throws runtime_error if the provided index (x, y) is out of bounds
  */
-void DotMatrixRenderer::draw(int x, int y, std::pair<std::string, Colour> state) {
-    std::cerr << "No implementation provided for `DotMatrixRenderer::draw(int, int, std::string)`" << std::endl;
-    exit(0);
+void DotMatrixRenderer::draw(int x, int y, Cell state) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        throw std::runtime_error("index out of bounds");
+    }
+    writePixel(x, y, state);
 }
 
 /**
- * @brief Displays in-game menu. Stub; method not yet implemented.
+ * @brief Displays in-game menu.
  *
- * With a provided menu text string and a vector containing all of the menu options, the menu is written to the
- * dot-matrix. Input is not handled here.
+ * The menu is written to the command line, as text cannot be displayed legibly on the dot matrix, and the dot matrix
+ * is cleared. Input is not handled here.
  *
  * @param menuText the text displayed at the top of the menu (e.g., the question)
  * @param options vector containing list of options the user may select
  */
 void DotMatrixRenderer::displayMenu(std::string menuText, std::vector<std::string> options) {
-    std::cerr
-            << "No implementation provided for `DotMatrixRenderer::displayMenu(std::string, std::vector<std::string>)`"
-            << std::endl;
-    exit(0);
+    clearPixels();
+    console.displayMenu(std::move(menuText), std::move(options));
 }
 
 /**
- * @brief Prints a message to the console. Stub; method not implemented yet.
+ * @brief Prints a message to the console.
  *
- * The console reset can be disabled to allow messages to be displayed one after the other where applicable.
+ * The console reset can be disabled to allow messages to be displayed one after the other where applicable. The dot
+ * matrix is cleared along with the console.
  *
  * @param message the message to be reset
  * @param reset whether the console should be reset
  */
 void DotMatrixRenderer::displayMessage(std::string message, bool reset) {
-    std::cerr << "No implementation provided for `DotMatrixRenderer::displayMessage(std::string, bool)`" << std::endl;
-    exit(0);
+    if (reset) {
+        clearPixels();
+    }
+    console.displayMessage(std::move(message), reset);
 }
@@ -9,26 +9,66 @@
 #ifndef DOT_MATRIX_RENDERER_H
 #define DOT_MATRIX_RENDERER_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include "Renderer.h"
+#include "ConsoleRenderer.h"
+
+#define DEFAULT_DOT_MATRIX_DEVICE "/dev/fb0"  // framebuffer device the dot matrix is attached to.
+#define COLOUR_COUNT 9  // number of values of the `Colour` enumeration.
 
 /**
  * @brief Declaration for concrete `DotMatrixRenderer` class.
- * 
- * Class provides an implementation of abstract superclass `Renderer` to be used to output to the command line. It 
- * provides appropriate constructor, destructor and draw method implementations.
+ *
+ * Class provides an implementation of abstract superclass `Renderer` to be used to output to a dot matrix display,
+ * driven through a memory-mapped pixel sink. Each cell of the matrix is shown by the LED pixel at the same position:
+ * cells holding a character are lit in the colour of the cell, and empty cells are unlit.
+ *
+ * The pixel sink is either a Linux framebuffer device, whose resolution and 16 or 32 bit pixel format are read from
+ * the device, or any other file, such as one in `/dev/shm`, which is treated as a 32 bit XRGB pixel array of the size
+ * of the matrix and is created if it does not exist. Pixels are written straight into the mapped memory, with no
+ * intermediate buffer.
+ *
+ * A dot matrix cannot display text legibly, so menus and messages are written to the command line instead, and the
+ * matrix is cleared while they are shown.
  */
 class DotMatrixRenderer : public Renderer {
+private:
+    int fd = -1;
+    unsigned char *mapping = nullptr;
+    std::size_t mappingSize = 0;
+    unsigned char *pixels = nullptr;
+    int deviceWidth = 0;
+    int deviceHeight = 0;
+    int stride = 0;
+    int bytesPerPixel = 0;
+    std::array<std::uint32_t, COLOUR_COUNT> palette{};
+    ConsoleRenderer console;
+
+    void openDevice(const std::string &device);
+
+    template<typename Pixel>
+    void drawPixels(const FrameBuffer &matrix);
+
+    void writePixel(int x, int y, const Cell &cell);
+
+    void clearPixels();
 
 public:
-    DotMatrixRenderer(int width, int height);
+    DotMatrixRenderer(int width, int height, const std::string &device = DEFAULT_DOT_MATRIX_DEVICE);
 
-    explicit DotMatrixRenderer(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix);
+    explicit DotMatrixRenderer(const FrameBuffer &matrix, const std::string &device = DEFAULT_DOT_MATRIX_DEVICE);
 
     ~DotMatrixRenderer() override;
 
-    void draw(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) override;
+    DotMatrixRenderer(const DotMatrixRenderer &renderer) = delete;
+
+    DotMatrixRenderer &operator=(const DotMatrixRenderer &renderer) = delete;
+
+    void draw(const FrameBuffer &matrix) override;
 
-    void draw(int x, int y, std::pair<std::string, Colour> state) override;
+    void draw(int x, int y, Cell state) override;
 
     void displayMenu(std::string menuText, std::vector<std::string> options) override;
 
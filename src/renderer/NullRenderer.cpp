@@ -0,0 +1,73 @@
+/**
+ * File contains concrete definition of `NullRenderer` subclass.
+ *
+ * @file NullRenderer.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include "NullRenderer.h"
+
+/**
+ * @brief Constructor for a renderer of the given dimensions.
+ *
+ * The constructor for abstract superclass `Renderer` is called with the provided parameters.
+ *
+ * @param width the width of the matrix
+ * @param height the height of the matrix
+ */
+NullRenderer::NullRenderer(int width, int height) : Renderer(width, height) {
+    frameCount = 0;
+}
+
+/**
+ * @brief Default destructor.
+ *
+ * No memory is allocated.
+ */
+NullRenderer::~NullRenderer() = default;
+
+/**
+ * @brief Discards the provided matrix, counting it as a drawn frame.
+ *
+ * @param matrix the matrix to be drawn
+ */
+void NullRenderer::draw(const FrameBuffer &matrix) {
+    frameCount++;
+}
+
+/**
+ * @brief Discards the provided change, counting it as a drawn frame.
+ *
+ * @param x the x-coordinate of the position in the matrix to be updated
+ * @param y the y-coordinate of the position in the matrix to be updated
+ * @param state the new cell of character and colour at the position to be updated
+ */
+void NullRenderer::draw(int x, int y, Cell state) {
+    frameCount++;
+}
+
+/**
+ * @brief Discards the provided menu.
+ *
+ * @param menuText the text displayed at the top of the menu (e.g., the question)
+ * @param options vector containing list of options the user may select
+ */
+void NullRenderer::displayMenu(std::string menuText, std::vector<std::string> options) {}
+
+/**
+ * @brief Discards the provided message.
+ *
+ * @param message the message to be displayed
+ * @param reset whether the display should be reset
+ */
+void NullRenderer::displayMessage(std::string message, bool reset) {}
+
+/**
+ * @brief Getter for the number of frames drawn.
+ *
+ * @return the number of frames drawn
+ */
+long NullRenderer::getFrameCount() const {
+    return frameCount;
+}
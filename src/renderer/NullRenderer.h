@@ -0,0 +1,40 @@
+/**
+ * File contains declaration for concrete `NullRenderer` class.
+ *
+ * @file NullRenderer.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef NULL_RENDERER_H
+#define NULL_RENDERER_H
+
+#include "Renderer.h"
+
+/**
+ * @brief Declaration for concrete `NullRenderer` class.
+ *
+ * Class provides an implementation of abstract superclass `Renderer` which displays nothing, for use when games are run
+ * without a display. Only the number of frames drawn is recorded.
+ */
+class NullRenderer : public Renderer {
+private:
+    long frameCount;
+
+public:
+    NullRenderer(int width, int height);
+
+    ~NullRenderer() override;
+
+    void draw(const FrameBuffer &matrix) override;
+
+    void draw(int x, int y, Cell state) override;
+
+    void displayMenu(std::string menuText, std::vector<std::string> options) override;
+
+    void displayMessage(std::string message, bool reset) override;
+
+    long getFrameCount() const;
+};
+
+#endif
@@ -12,8 +12,8 @@
 /**
  * @brief Constructor for when no matrix is provided.
  *
- * Constructs new instance with the provided width and height, with the previous matrix being initialised as an empty 
- * vector.
+ * Constructs new instance with the provided width and height, with the previous matrix being initialised as an empty
+ * frame buffer.
  * 
  * @param width the width of the matrix
  * @param height the height of the matrix
@@ -21,7 +21,7 @@
 Renderer::Renderer(int width, int height) {
     this->width = width;
     this->height = height;
-    this->previousMatrix = {};
+    this->previousMatrix = FrameBuffer();
 }
 
 /**
@@ -30,11 +30,11 @@ Renderer::Renderer(int width, int height) {
  * Constructs new instance with the width and height of the provided matrix, with the previous matrix set as the matrix 
  * provided.
  * 
- * @param matrix the 2D vector to be used to construct renderer (and to be displayed)
+ * @param matrix the frame buffer to be used to construct renderer (and to be displayed)
  */
-Renderer::Renderer(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) {
-    this->width = matrix[0].size();
-    this->height = matrix.size();
+Renderer::Renderer(const FrameBuffer &matrix) {
+    this->width = matrix.getWidth();
+    this->height = matrix.getHeight();
     this->previousMatrix = matrix;
 }
 
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include "../Colour.h"
+#include "../FrameBuffer.h"
 
 /**
  * @brief Declaration for abstract `Renderer` class.
@@ -24,12 +25,12 @@ class Renderer {
 protected:
     int width;
     int height;
-    std::vector<std::vector<std::pair<std::string, Colour>>> previousMatrix;
+    FrameBuffer previousMatrix;
 
 public:
     Renderer(int width, int height);
 
-    explicit Renderer(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix);
+    explicit Renderer(const FrameBuffer &matrix);
 
     virtual ~Renderer() = 0;
 
@@ -37,9 +38,9 @@ public:
 
     int getHeight() const;
 
-    virtual void draw(const std::vector<std::vector<std::pair<std::string, Colour>>> &matrix) = 0;
+    virtual void draw(const FrameBuffer &matrix) = 0;
 
-    virtual void draw(int x, int y, std::pair<std::string, Colour> state) = 0;
+    virtual void draw(int x, int y, Cell state) = 0;
 
     virtual void displayMenu(std::string menuText, std::vector<std::string> options) = 0;
 
@@ -0,0 +1,72 @@
+/**
+ * File contains the layout of the shared memory region frames are exported through by `SharedMemoryRenderer`.
+ *
+ * @file SharedFrame.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef SHARED_FRAME_H
+#define SHARED_FRAME_H
+
+#include <atomic>
+#include <cstdint>
+#include "../FrameBuffer.h"
+
+#define SHARED_FRAME_MAGIC 0x46504d44u  // "DMPF" in little-endian byte order, identifying a frame export region.
+#define SHARED_FRAME_VERSION 1  // version of the region layout, incremented whenever it changes.
+#define SHARED_FRAME_SLOTS 4  // number of frames held by the ring.
+#define SHARED_GLYPH_BYTES 8  // bytes per exported glyph: a NUL padded UTF-8 character.
+#define SHARED_ALIGNMENT 64  // alignment of each section of the region, a cache line, so that slots do not share lines.
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared atomics must be lock free");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared atomics must be lock free");
+
+/**
+ * @brief Declaration of `SharedFrameHeader` structure.
+ *
+ * Found at the start of a frame export region. The region holds, in order and each aligned to `SHARED_ALIGNMENT`
+ * bytes, this header, the glyph table and a ring of `slotCount` frame slots, each `slotSize` bytes long.
+ *
+ * Frame `n`, counting from zero, is written to slot `n % slotCount`, so the latest frame is in the slot of frame
+ * `frameCount - 1`. The glyph table holds the UTF-8 character of each glyph id below `glyphCount`; as ids below 128
+ * are ASCII characters, readers which only display ASCII may ignore it.
+ */
+struct SharedFrameHeader {
+    std::atomic<std::uint32_t> magic;  // written last, so readers which load it with acquire see the header.
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t cellSize;
+    std::uint32_t slotCount;
+    std::uint32_t slotSize;
+    std::uint32_t glyphOffset;
+    std::uint32_t slotOffset;
+    std::atomic<std::uint32_t> glyphCount;
+    std::atomic<std::uint64_t> frameCount;
+};
+
+/**
+ * @brief Declaration of `SharedFrameSlot` structure.
+ *
+ * A slot of the frame ring, followed immediately by the `width * height` cells of its frame in row-major order.
+ *
+ * The slot is guarded by a sequence lock. The writer makes the sequence odd before writing the frame and even again
+ * afterwards, so a reader has read a consistent frame if the sequence was even before it copied the cells and is
+ * unchanged after.
+ */
+struct SharedFrameSlot {
+    std::atomic<std::uint32_t> sequence;
+    std::uint32_t reserved;
+    std::uint64_t frameNumber;
+
+    Cell *cells() {
+        return reinterpret_cast<Cell *>(this + 1);
+    }
+
+    const Cell *cells() const {
+        return reinterpret_cast<const Cell *>(this + 1);
+    }
+};
+
+#endif
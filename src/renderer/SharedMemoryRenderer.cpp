@@ -0,0 +1,252 @@
+/**
+ * File contains concrete definition of `SharedMemoryRenderer` subclass.
+ *
+ * @file SharedMemoryRenderer.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../GlyphTable.h"
+#include "SharedMemoryRenderer.h"
+
+/**
+ * @brief Static helper function rounds a size up to the alignment of the sections of the region.
+ *
+ * @param size the size to round up
+ * @return the rounded size
+ */
+static std::size_t alignSection(std::size_t size) {
+    return (size + SHARED_ALIGNMENT - 1) / SHARED_ALIGNMENT * SHARED_ALIGNMENT;
+}
+
+/**
+ * @brief Constructor for a renderer exporting frames through the named shared memory region.
+ *
+ * The region is created and sized for frames of the dimensions of the provided renderer. A region of the same name left
+ * by an earlier run is unlinked and replaced rather than reused, so viewers which still map it keep their mapping
+ * instead of having it shrunk under them. A leading slash is added to the name if it has none, as POSIX requires.
+ *
+ * @param name the name of the shared memory region
+ * @param renderer the renderer everything drawn is passed on to, which is owned and destroyed by this renderer
+ * @throws runtime_error if the region cannot be created or mapped
+ */
+SharedMemoryRenderer::SharedMemoryRenderer(const std::string &name, Renderer *renderer)
+        : Renderer(renderer->getWidth(), renderer->getHeight()), renderer(renderer) {
+    this->name = name.empty() || name[0] != '/' ? "/" + name : name;
+    std::size_t cellBytes = (std::size_t)width * height * sizeof(Cell);
+    std::size_t glyphOffset = alignSection(sizeof(SharedFrameHeader));
+    std::size_t slotOffset = glyphOffset + alignSection(MAX_GLYPHS * SHARED_GLYPH_BYTES);
+    std::size_t slotSize = alignSection(sizeof(SharedFrameSlot) + cellBytes);
+    regionSize = slotOffset + slotSize * SHARED_FRAME_SLOTS;
+
+    shm_unlink(this->name.c_str());
+    fd = shm_open(this->name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(this->name + ": " + std::strerror(errno));
+    }
+    if (ftruncate(fd, (off_t)regionSize) < 0) {
+        std::string reason = std::strerror(errno);
+        close(fd);
+        shm_unlink(this->name.c_str());
+        throw std::runtime_error(this->name + ": " + reason);
+    }
+    void *memory = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::string reason = std::strerror(errno);
+        close(fd);
+        shm_unlink(this->name.c_str());
+        throw std::runtime_error(this->name + ": " + reason);
+    }
+    region = static_cast<unsigned char *>(memory);
+
+    // The new region is zeroed when it is sized, so only the fields which are not zero need to be written.
+    header = new(region) SharedFrameHeader{};
+    header->version = SHARED_FRAME_VERSION;
+    header->width = (std::uint32_t)width;
+    header->height = (std::uint32_t)height;
+    header->cellSize = sizeof(Cell);
+    header->slotCount = SHARED_FRAME_SLOTS;
+    header->slotSize = (std::uint32_t)slotSize;
+    header->glyphOffset = (std::uint32_t)glyphOffset;
+    header->slotOffset = (std::uint32_t)slotOffset;
+    for (int slot = 0; slot < SHARED_FRAME_SLOTS; slot++) {
+        new(getSlot(slot)) SharedFrameSlot{};
+    }
+    exportGlyphs();
+    // The magic number is written last, so that readers which find it see a complete header.
+    header->magic.store(SHARED_FRAME_MAGIC, std::memory_order_release);
+}
+
+/**
+ * @brief Destructor unmaps and removes the shared memory region, and destroys the renderer drawn through.
+ *
+ * Readers which still have the region mapped may continue to read the last frames exported.
+ */
+SharedMemoryRenderer::~SharedMemoryRenderer() {
+    munmap(region, regionSize);
+    close(fd);
+    shm_unlink(name.c_str());
+}
+
+/**
+ * @brief Gets the slot of the ring a frame is written to.
+ *
+ * @param frame the number of the frame
+ * @return pointer to the slot
+ */
+SharedFrameSlot *SharedMemoryRenderer::getSlot(std::uint64_t frame) const {
+    return reinterpret_cast<SharedFrameSlot *>(region + header->slotOffset +
+                                               (frame % SHARED_FRAME_SLOTS) * header->slotSize);
+}
+
+/**
+ * @brief Copies any glyphs interned since the last export into the glyph table of the region.
+ *
+ * Entries of the table are only ever appended, so readers need no lock to read them. Characters longer than an entry
+ * are truncated.
+ */
+void SharedMemoryRenderer::exportGlyphs() {
+    GlyphTable &table = GlyphTable::getInstance();
+    int glyphCount = table.size();
+    if (glyphCount == exportedGlyphCount) {
+        return;
+    }
+    char *glyphs = reinterpret_cast<char *>(region + header->glyphOffset);
+    for (int id = exportedGlyphCount; id < glyphCount; id++) {
+        std::strncpy(glyphs + id * SHARED_GLYPH_BYTES, table.lookup((GlyphId)id).c_str(), SHARED_GLYPH_BYTES - 1);
+    }
+    exportedGlyphCount = glyphCount;
+    header->glyphCount.store((std::uint32_t)glyphCount, std::memory_order_release);
+}
+
+/**
+ * @brief Writes a frame into the next slot of the ring under its sequence lock, then makes it the latest frame.
+ *
+ * A single cell of the frame may be replaced as it is written, so that a change to the previous frame can be exported
+ * without building the new frame elsewhere first.
+ *
+ * @param cells the cells of the frame
+ * @param changedX the x-coordinate of the cell replaced, or -1 if no cell is replaced
+ * @param changedY the y-coordinate of the cell replaced
+ * @param changed the replacement cell
+ */
+void SharedMemoryRenderer::publish(const Cell *cells, int changedX, int changedY, Cell changed) {
+    exportGlyphs();
+    SharedFrameSlot *slot = getSlot(frameCount);
+    std::uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->frameNumber = frameCount;
+    std::memcpy(slot->cells(), cells, (std::size_t)width * height * sizeof(Cell));
+    if (changedX >= 0) {
+        slot->cells()[changedY * width + changedX] = changed;
+    }
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    header->frameCount.store(++frameCount, std::memory_order_release);
+}
+
+/**
+ * @brief Exports the provided matrix and passes it on to the renderer drawn through.
+ *
+ * Matrices of different dimensions to the region are passed on but not exported.
+ *
+ * @param matrix the matrix to be drawn
+ */
+void SharedMemoryRenderer::draw(const FrameBuffer &matrix) {
+    if (matrix.getWidth() == width && matrix.getHeight() == height) {
+        publish(matrix.row(0));
+    }
+    renderer->draw(matrix);
+}
+
+/**
+ * @brief Exports the previous frame with the change provided at given coordinates, and passes the change on.
+ *
+ * @param x the x-coordinate of the position in the matrix to be updated
+ * @param y the y-coordinate of the position in the matrix to be updated
+ * @param state the new cell of character and colour for the position to be updated
+ */
+void SharedMemoryRenderer::draw(int x, int y, Cell state) {
+    renderer->draw(x, y, state);
+    if (frameCount > 0) {
+        publish(getSlot(frameCount - 1)->cells(), x, y, state);
+    }
+}
+
+/**
+ * @brief Displays in-game menu through the renderer drawn through.
+ *
+ * Menus are not exported.
+ *
+ * @param menuText the text displayed at the top of the menu (e.g., the question)
+ * @param options vector containing list of options the user may select
+ */
+void SharedMemoryRenderer::displayMenu(std::string menuText, std::vector<std::string> options) {
+    renderer->displayMenu(std::move(menuText), std::move(options));
+}
+
+/**
+ * @brief Displays a message through the renderer drawn through.
+ *
+ * Messages are not exported.
+ *
+ * @param message the message to be displayed
+ * @param reset whether the display should be reset
+ */
+void SharedMemoryRenderer::displayMessage(std::string message, bool reset) {
+    renderer->displayMessage(std::move(message), reset);
+}
+
+/**
+ * @brief Getter for the name of the shared memory region.
+ *
+ * @return the name of the region, including its leading slash
+ */
+const std::string &SharedMemoryRenderer::getName() const {
+    return name;
+}
+
+/**
+ * @brief Reads the latest frame from a mapped frame export region.
+ *
+ * The frame is copied out of its slot and the copy is kept only if the sequence lock of the slot shows that it was not
+ * overwritten meanwhile. As the ring holds several frames, the writer must lap the ring during the copy for it to be
+ * retried, so retries are rare.
+ *
+ * @param header the header of the mapped region, which must have a valid magic number and version
+ * @param cells filled with the `width * height` cells of the frame
+ * @param frameNumber set to the number of the frame read
+ * @return true if a frame was read, or false if no frame has been exported or every attempt was overwritten
+ */
+bool SharedMemoryRenderer::readFrame(const SharedFrameHeader *header, Cell *cells, std::uint64_t &frameNumber) {
+    auto *base = reinterpret_cast<const unsigned char *>(header);
+    std::size_t cellBytes = (std::size_t)header->width * header->height * header->cellSize;
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+        std::uint64_t count = header->frameCount.load(std::memory_order_acquire);
+        if (count == 0) {
+            return false;
+        }
+        auto *slot = reinterpret_cast<const SharedFrameSlot *>(
+                base + header->slotOffset + ((count - 1) % header->slotCount) * header->slotSize);
+        std::uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence % 2 != 0) {
+            continue;
+        }
+        std::uint64_t number = slot->frameNumber;
+        std::memcpy(cells, slot->cells(), cellBytes);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) == sequence) {
+            frameNumber = number;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,70 @@
+/**
+ * File contains declaration for concrete `SharedMemoryRenderer` class.
+ *
+ * @file SharedMemoryRenderer.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef SHARED_MEMORY_RENDERER_H
+#define SHARED_MEMORY_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Renderer.h"
+#include "SharedFrame.h"
+
+#define MAX_READ_ATTEMPTS 16  // attempts made to read a frame which is being overwritten before giving up.
+
+/**
+ * @brief Declaration for concrete `SharedMemoryRenderer` class.
+ *
+ * Class provides an implementation of abstract superclass `Renderer` which exports every frame drawn into a POSIX
+ * shared memory region, laid out as described in `SharedFrame.h`, so that other local processes, such as a viewer, a
+ * recorder or an LED driver, can read the frames without copying them through a pipe or socket. Exporting a frame
+ * costs a single copy of its cells into the next slot of the ring.
+ *
+ * Everything drawn is also passed on to another renderer, which displays the game and its menus as usual. The region
+ * is removed when the renderer is destroyed.
+ */
+class SharedMemoryRenderer : public Renderer {
+private:
+    std::unique_ptr<Renderer> renderer;
+    std::string name;
+    int fd = -1;
+    unsigned char *region = nullptr;
+    std::size_t regionSize = 0;
+    SharedFrameHeader *header = nullptr;
+    std::uint64_t frameCount = 0;
+    int exportedGlyphCount = 0;
+
+    SharedFrameSlot *getSlot(std::uint64_t frame) const;
+
+    void exportGlyphs();
+
+    void publish(const Cell *cells, int changedX = -1, int changedY = -1, Cell changed = {});
+
+public:
+    SharedMemoryRenderer(const std::string &name, Renderer *renderer);
+
+    ~SharedMemoryRenderer() override;
+
+    SharedMemoryRenderer(const SharedMemoryRenderer &renderer) = delete;
+
+    SharedMemoryRenderer &operator=(const SharedMemoryRenderer &renderer) = delete;
+
+    void draw(const FrameBuffer &matrix) override;
+
+    void draw(int x, int y, Cell state) override;
+
+    void displayMenu(std::string menuText, std::vector<std::string> options) override;
+
+    void displayMessage(std::string message, bool reset) override;
+
+    const std::string &getName() const;
+
+    static bool readFrame(const SharedFrameHeader *header, Cell *cells, std::uint64_t &frameNumber);
+};
+
+#endif
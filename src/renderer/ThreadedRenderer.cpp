@@ -0,0 +1,150 @@
+/**
+ * File contains concrete definition of `ThreadedRenderer` subclass.
+ *
+ * @file ThreadedRenderer.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <utility>
+#include "ThreadedRenderer.h"
+#include "../TraceWriter.h"
+
+/**
+ * @brief Constructor for a renderer drawing through the provided renderer on a new render thread.
+ *
+ * The buffers are allocated at the size of the provided renderer, so that frames of that size are copied into them
+ * without allocating.
+ *
+ * @param renderer the renderer frames are drawn with, which is owned and destroyed by this renderer
+ */
+ThreadedRenderer::ThreadedRenderer(Renderer *renderer)
+        : Renderer(renderer->getWidth(), renderer->getHeight()), renderer(renderer) {
+    for (FrameBuffer &buffer: buffers) {
+        buffer = FrameBuffer(width, height);
+    }
+    renderThread = std::thread(&ThreadedRenderer::renderLoop, this);
+}
+
+/**
+ * @brief Destructor stops the render thread and destroys the renderer frames are drawn with.
+ *
+ * A frame which has not yet been drawn is dropped.
+ */
+ThreadedRenderer::~ThreadedRenderer() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    frameCondition.notify_one();
+    renderThread.join();
+}
+
+/**
+ * @brief Body of the render thread, which draws each frame made ready until the renderer is destroyed.
+ *
+ * The ready buffer is swapped with the front buffer under the lock, and the front buffer is then drawn without it.
+ */
+void ThreadedRenderer::renderLoop() {
+    TraceWriter::nameThread("render");
+    std::unique_lock<std::mutex> lock(stateMutex);
+    while (true) {
+        frameCondition.wait(lock, [this] { return frameReady || stopping; });
+        if (stopping) {
+            break;
+        }
+        std::swap(frontIndex, readyIndex);
+        frameReady = false;
+        drawing = true;
+        lock.unlock();
+        renderer->draw(buffers[frontIndex]);
+        lock.lock();
+        drawing = false;
+        idleCondition.notify_all();
+    }
+}
+
+/**
+ * @brief Passes the provided matrix to the render thread to be drawn, without waiting for it to be drawn.
+ *
+ * @param matrix the matrix to be drawn
+ */
+void ThreadedRenderer::draw(const FrameBuffer &matrix) {
+    buffers[backIndex] = matrix;  // the back buffer is only used by this thread, so is copied outside of the lock.
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        std::swap(backIndex, readyIndex);
+        if (frameReady) {
+            droppedFrameCount++;
+        }
+        frameReady = true;
+        frameCount++;
+    }
+    frameCondition.notify_one();
+}
+
+/**
+ * @brief Updates the matrix displayed with the change provided at given coordinates.
+ *
+ * Waits for the last frame passed to the render thread to be drawn, so that the change is made to that frame.
+ *
+ * @param x the x-coordinate of the position in the matrix to be updated
+ * @param y the y-coordinate of the position in the matrix to be updated
+ * @param state the new cell of character and colour for the position to be updated
+ */
+void ThreadedRenderer::draw(int x, int y, Cell state) {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    idleCondition.wait(lock, [this] { return !frameReady && !drawing; });
+    renderer->draw(x, y, state);
+}
+
+/**
+ * @brief Displays in-game menu.
+ *
+ * Any frame not yet drawn is dropped and the render thread is waited for, so that no frame is drawn over the menu.
+ * The render thread cannot start another frame while the menu is displayed, as the lock is held.
+ *
+ * @param menuText the text displayed at the top of the menu (e.g., the question)
+ * @param options vector containing list of options the user may select
+ */
+void ThreadedRenderer::displayMenu(std::string menuText, std::vector<std::string> options) {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    frameReady = false;
+    idleCondition.wait(lock, [this] { return !drawing; });
+    renderer->displayMenu(std::move(menuText), std::move(options));
+}
+
+/**
+ * @brief Displays a message.
+ *
+ * Any frame not yet drawn is dropped and the render thread is waited for, so that no frame is drawn over the message.
+ *
+ * @param message the message to be displayed
+ * @param reset whether the display should be reset
+ */
+void ThreadedRenderer::displayMessage(std::string message, bool reset) {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    frameReady = false;
+    idleCondition.wait(lock, [this] { return !drawing; });
+    renderer->displayMessage(std::move(message), reset);
+}
+
+/**
+ * @brief Getter for the number of frames passed to the render thread.
+ *
+ * @return the number of frames
+ */
+long ThreadedRenderer::getFrameCount() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return frameCount;
+}
+
+/**
+ * @brief Getter for the number of frames dropped as a newer frame was ready before they were drawn.
+ *
+ * @return the number of frames dropped
+ */
+long ThreadedRenderer::getDroppedFrameCount() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return droppedFrameCount;
+}
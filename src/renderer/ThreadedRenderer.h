@@ -0,0 +1,75 @@
+/**
+ * File contains declaration for concrete `ThreadedRenderer` class.
+ *
+ * @file ThreadedRenderer.h
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#ifndef THREADED_RENDERER_H
+#define THREADED_RENDERER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Renderer.h"
+
+#define FRAME_BUFFER_COUNT 3  // frames held by the triple buffer: being written, ready and being drawn.
+
+/**
+ * @brief Declaration for concrete `ThreadedRenderer` class.
+ *
+ * Class provides an implementation of abstract superclass `Renderer` which draws frames on a dedicated render thread,
+ * using another renderer, so that a slow output device never stalls the game loop.
+ *
+ * Frames are passed to the render thread through a triple buffer. Drawing a frame copies it into the back buffer and
+ * swaps it with the ready buffer, which the render thread swaps with the front buffer it draws from. Only the swaps are
+ * made under a lock, so the game loop never waits for a frame to be drawn. If a new frame is ready before the render
+ * thread has taken the previous one, the previous frame is stale and is dropped.
+ *
+ * Menus and messages are displayed on the calling thread, once the render thread is idle, and discard any frame which
+ * has not yet been drawn so that it cannot overwrite them.
+ */
+class ThreadedRenderer : public Renderer {
+private:
+    std::unique_ptr<Renderer> renderer;
+    FrameBuffer buffers[FRAME_BUFFER_COUNT];
+    int backIndex = 0;
+    int readyIndex = 1;
+    int frontIndex = 2;
+    bool frameReady = false;
+    bool drawing = false;
+    bool stopping = false;
+    long frameCount = 0;
+    long droppedFrameCount = 0;
+    mutable std::mutex stateMutex;
+    std::condition_variable frameCondition;
+    std::condition_variable idleCondition;
+    std::thread renderThread;
+
+    void renderLoop();
+
+public:
+    explicit ThreadedRenderer(Renderer *renderer);
+
+    ~ThreadedRenderer() override;
+
+    ThreadedRenderer(const ThreadedRenderer &renderer) = delete;
+
+    ThreadedRenderer &operator=(const ThreadedRenderer &renderer) = delete;
+
+    void draw(const FrameBuffer &matrix) override;
+
+    void draw(int x, int y, Cell state) override;
+
+    void displayMenu(std::string menuText, std::vector<std::string> options) override;
+
+    void displayMessage(std::string message, bool reset) override;
+
+    long getFrameCount() const;
+
+    long getDroppedFrameCount() const;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * File contains a viewer which displays the frames exported by a running game through shared memory, built by the
+ * `FrameViewer` make target.
+ *
+ * @file FrameViewer.cpp
+ * @co_author https://github.com/Jon-AL
+ * @date 16/10/26
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../GlyphTable.h"
+#include "../renderer/ConsoleRenderer.h"
+#include "../renderer/SharedMemoryRenderer.h"
+
+#define POLL_INTERVAL std::chrono::milliseconds(10)  // time waited between checks for a new frame.
+
+/**
+ * @brief Maps the glyph ids of the exporting game to the glyph ids of this process, interning any new glyphs.
+ *
+ * ASCII characters have the same id in every process, so only the ids of other glyphs are looked up.
+ *
+ * @param header the header of the mapped region
+ * @param localIds the local id of each exported glyph id, extended with the glyphs exported since the last call
+ */
+static void importGlyphs(const SharedFrameHeader *header, std::vector<GlyphId> &localIds) {
+    std::uint32_t glyphCount = std::min<std::uint32_t>(header->glyphCount.load(std::memory_order_acquire), MAX_GLYPHS);
+    const char *glyphs = reinterpret_cast<const char *>(header) + header->glyphOffset;
+    for (std::uint32_t id = localIds.size(); id < glyphCount; id++) {
+        if (id < ASCII_GLYPHS) {
+            localIds.push_back((GlyphId)id);
+        } else {
+            const char *glyph = glyphs + id * SHARED_GLYPH_BYTES;
+            std::string_view character(glyph, strnlen(glyph, SHARED_GLYPH_BYTES));
+            localIds.push_back(GlyphTable::getInstance().intern(character));
+        }
+    }
+}
+
+/**
+ * @brief Checks that the sections described by the header of a region lie within the size mapped, so that reading
+ * them cannot run past the end of the mapping.
+ *
+ * @param header the header of the mapped region, whose magic number, version and cell size have been checked
+ * @param size the size of the mapped region
+ * @return true if the glyph table and every slot fit within the region
+ */
+static bool isWithinRegion(const SharedFrameHeader *header, std::size_t size) {
+    if (header->width == 0 || header->height == 0 || header->slotCount == 0 ||
+        header->glyphOffset < sizeof(SharedFrameHeader) || header->slotSize < sizeof(SharedFrameSlot)) {
+        return false;
+    }
+    // Compared in 64 bits, so that no sum or product of the 32 bit fields can overflow.
+    std::uint64_t cells = (std::uint64_t)header->width * header->height;
+    return (std::uint64_t)header->glyphOffset + MAX_GLYPHS * SHARED_GLYPH_BYTES <= header->slotOffset &&
+           cells <= (header->slotSize - sizeof(SharedFrameSlot)) / sizeof(Cell) &&
+           header->slotOffset + (std::uint64_t)header->slotCount * header->slotSize <= size;
+}
+
+/**
+ * @brief Main function displays the frames of a running game on the command line until it is interrupted.
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments: the name of the shared memory region the game exports frames through
+ * @return 0 when the game stops exporting frames, or 1 if the region cannot be read
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <shared memory name>" << std::endl;
+        return 1;
+    }
+    std::string name = argv[1][0] == '/' ? argv[1] : "/" + std::string(argv[1]);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    struct stat status{};
+    if (fd < 0 || fstat(fd, &status) < 0 || (std::size_t)status.st_size < sizeof(SharedFrameHeader)) {
+        std::cerr << name << ": unable to open shared memory, is the game running with --export-shm?" << std::endl;
+        return 1;
+    }
+    void *memory = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::perror(name.c_str());
+        return 1;
+    }
+    const auto *header = static_cast<const SharedFrameHeader *>(memory);
+    // The magic number is checked first, as its acquire orders the reads of the rest of the header after it.
+    if (header->magic.load(std::memory_order_acquire) != SHARED_FRAME_MAGIC ||
+        header->version != SHARED_FRAME_VERSION || header->cellSize != sizeof(Cell)) {
+        std::cerr << name << ": not a frame export region of this version" << std::endl;
+        return 1;
+    }
+    if (!isWithinRegion(header, (std::size_t)status.st_size)) {
+        std::cerr << name << ": frame export region is truncated or corrupt" << std::endl;
+        return 1;
+    }
+
+    int width = (int)header->width;
+    int height = (int)header->height;
+    ConsoleRenderer renderer(width, height);
+    FrameBuffer frame(width, height);
+    std::vector<GlyphId> localIds;
+    std::uint64_t lastFrame = UINT64_MAX;
+    std::uint64_t frameNumber;
+    while (true) {
+        if (SharedMemoryRenderer::readFrame(header, frame.row(0), frameNumber) && frameNumber != lastFrame) {
+            importGlyphs(header, localIds);
+            for (int y = 0; y < height; y++) {
+                Cell *row = frame.row(y);
+                for (int x = 0; x < width; x++) {
+                    row[x].glyph = row[x].glyph < localIds.size() ? localIds[row[x].glyph] : (GlyphId)'?';
+                }
+            }
+            renderer.draw(frame);
+            lastFrame = frameNumber;
+        }
+        // The game removes the region when it exits, so stop once it no longer exists.
+        int check = shm_open(name.c_str(), O_RDONLY, 0);
+        if (check < 0) {
+            break;
+        }
+        close(check);
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+    munmap(memory, status.st_size);
+    close(fd);
+    return 0;
+}